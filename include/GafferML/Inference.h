@@ -40,6 +40,7 @@
 #include "GafferML/TensorPlug.h"
 
 #include "Gaffer/ArrayPlug.h"
+#include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/TypedObjectPlug.h"
@@ -68,6 +69,12 @@ class GAFFERML_API Inference : public Gaffer::ComputeNode
 		Gaffer::ArrayPlug *outPlug();
 		const Gaffer::ArrayPlug *outPlug() const;
 
+		Gaffer::V2iPlug *tileSizePlug();
+		const Gaffer::V2iPlug *tileSizePlug() const;
+
+		Gaffer::IntPlug *tilePaddingPlug();
+		const Gaffer::IntPlug *tilePaddingPlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 	protected :
@@ -46,6 +46,8 @@
 #include "GafferImage/ImageProcessor.h"
 #include "GafferImage/Constant.h"
 
+#include "Gaffer/NumericPlug.h"
+
 namespace GafferOSL
 {
 
@@ -62,6 +64,9 @@ class GAFFEROSL_API OSLImage : public GafferImage::ImageProcessor
 		GafferImage::FormatPlug *defaultFormatPlug();
 		const GafferImage::FormatPlug *defaultFormatPlug() const;
 
+		Gaffer::BoolPlug *useBatchedShadingPlug();
+		const Gaffer::BoolPlug *useBatchedShadingPlug() const;
+
 		Gaffer::Plug *channelsPlug();
 		const Gaffer::Plug *channelsPlug() const;
 
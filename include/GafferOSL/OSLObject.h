@@ -109,6 +109,9 @@ class GAFFEROSL_API OSLObject : public GafferScene::Deformer
 		Gaffer::BoolPlug *ignoreMissingSourceLocationsPlug();
 		const Gaffer::BoolPlug *ignoreMissingSourceLocationsPlug() const;
 
+		Gaffer::BoolPlug *useBatchedShadingPlug();
+		const Gaffer::BoolPlug *useBatchedShadingPlug() const;
+
 		Gaffer::Plug *primitiveVariablesPlug();
 		const Gaffer::Plug *primitiveVariablesPlug() const;
 
@@ -41,9 +41,12 @@
 #include "IECoreScene/ShaderNetwork.h"
 
 #include "IECore/CompoundData.h"
+#include "IECore/VectorTypedData.h"
 
 #include "boost/container/flat_set.hpp"
 
+#include <memory>
+
 namespace GafferOSL
 {
 
@@ -85,19 +88,25 @@ class GAFFEROSL_API ShadingEngine : public IECore::RefCounted
 
 		using Transforms = std::map<IECore::InternedString, Transform>;
 		using PointClouds = std::map<IECore::InternedString, IECoreScene::ConstPrimitivePtr>;
+		/// Indices for indexed variables in `points`. These are used to look
+		/// up values on demand, avoiding the need to expand the data first.
+		using Indices = std::map<IECore::InternedString, IECore::ConstIntVectorDataPtr>;
 
 		/// Append a unique hash representing this shading engine to `h`.
 		void hash( IECore::MurmurHash &h ) const;
 		IECore::CompoundDataPtr shade( const IECore::CompoundData *points, const Transforms &transforms = Transforms() ) const;
 		IECore::CompoundDataPtr shade( const IECore::CompoundData *points, const Transforms &transforms, const PointClouds &pointClouds ) const;
+		/// If `useBatchedShading` is false, points are shaded one at a time even if
+		/// the ShadingSystem supports batched execution. Batched shading also falls
+		/// back to one-at-a-time shading automatically if the network can't be
+		/// compiled for batched execution.
+		IECore::CompoundDataPtr shade( const IECore::CompoundData *points, const Transforms &transforms, const PointClouds &pointClouds, const Indices &indices, bool useBatchedShading = true ) const;
 
 		bool needsAttribute( const std::string &name ) const;
 		bool hasDeformation() const;
 
 	private :
 
-		void queryShaderGroup();
-
 		const IECore::MurmurHash m_hash;
 
 		bool m_timeNeeded;
@@ -111,7 +120,8 @@ class GAFFEROSL_API ShadingEngine : public IECore::RefCounted
 
 		bool m_hasDeformation;
 
-		void *m_shaderGroupRef;
+		// Shared between all ShadingEngines with the same network.
+		std::shared_ptr<const void> m_shaderGroup;
 
 };
 
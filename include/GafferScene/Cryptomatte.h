@@ -117,6 +117,9 @@ class GAFFERSCENE_API Cryptomatte : public GafferImage::FlatImageProcessor
 		Gaffer::FloatVectorDataPlug *matteChannelDataPlug();
 		const Gaffer::FloatVectorDataPlug *matteChannelDataPlug() const;
 
+		Gaffer::ObjectPlug *manifestIndexPlug();
+		const Gaffer::ObjectPlug *manifestIndexPlug() const;
+
 		static size_t g_firstPlugIndex;
 };
 
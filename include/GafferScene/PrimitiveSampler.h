@@ -39,6 +39,7 @@
 #include "GafferScene/Deformer.h"
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "IECoreScene/PrimitiveEvaluator.h"
 
@@ -71,6 +72,8 @@ class GAFFERSCENE_API PrimitiveSampler : public Deformer
 		Gaffer::StringPlug *statusPlug();
 		const Gaffer::StringPlug *statusPlug() const;
 
+		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+
 	protected :
 
 		explicit PrimitiveSampler( const std::string &name = defaultName<PrimitiveSampler>() );
@@ -113,8 +116,18 @@ class GAFFERSCENE_API PrimitiveSampler : public Deformer
 		/// `index` values in the interval `[ 0, destinationPrimitive->variableSize( interpolation ) )`.
 		virtual SamplingFunction computeSamplingFunction( const IECoreScene::Primitive *destinationPrimitive, IECoreScene::PrimitiveVariable::Interpolation &interpolation ) const = 0;
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
+
 	private :
 
+		/// The PrimitiveEvaluator for the source primitive is computed on this
+		/// internal plug, in a context where `scene:path` holds the source location.
+		/// This allows it to be built once and shared by all destination locations.
+		Gaffer::ObjectPlug *sourceEvaluatorPlug();
+		const Gaffer::ObjectPlug *sourceEvaluatorPlug() const;
+
 		bool affectsProcessedObject( const Gaffer::Plug *input ) const final;
 		void hashProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const final;
 		IECore::ConstObjectPtr computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, const IECore::Object *inputObject ) const final;
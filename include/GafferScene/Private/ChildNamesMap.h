@@ -40,12 +40,9 @@
 #include "IECore/PathMatcherData.h"
 #include "IECore/VectorTypedData.h"
 
-#include "boost/multi_index/hashed_index.hpp"
-#include "boost/multi_index/key.hpp"
-#include "boost/multi_index_container.hpp"
-
-#include <vector>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace GafferScene
 {
@@ -72,31 +69,43 @@ class ChildNamesMap : public IECore::Data
 		/// Returns the merged child names.
 		const IECore::InternedStringVectorData *outputChildNames() const;
 		/// Returns the input which is mapped to `outputName`.
-		const Input &input( IECore::InternedString outputName ) const;
+		Input input( IECore::InternedString outputName ) const;
 		/// Combines multiple input sets, accounting for the name remapping.
 		IECore::PathMatcher set( const std::vector<IECore::ConstPathMatcherDataPtr> &inputSets ) const;
 
 		static IECore::InternedString uniqueName( IECore::InternedString name, const std::unordered_set<IECore::InternedString> &existingNames );
 
+		void memoryUsage( IECore::Object::MemoryAccumulator &accumulator ) const override;
+
 	private :
 
-		const IECore::InternedStringVectorDataPtr m_childNames;
+		size_t inputIndex( size_t outputIndex ) const;
+		bool isUnrenamedChild( IECore::InternedString inputName, size_t inputIndex ) const;
 
-		struct Child
+		// Output names are stored in input order, so the children
+		// of input `i` occupy the range starting at `m_inputOffsets[i]`.
+		// In the common case that no renaming is required, and there is
+		// only a single non-empty input, we share its data directly.
+		IECore::ConstInternedStringVectorDataPtr m_childNames;
+		const std::vector<IECore::ConstInternedStringVectorDataPtr> m_inputChildNames;
+		std::vector<size_t> m_inputOffsets;
+
+		struct InternedStringHash
 		{
-			const Input input;
-			const IECore::InternedString output;
+			size_t operator()( const IECore::InternedString &name ) const;
 		};
 
-		using Map = boost::multi_index::multi_index_container<
-			Child,
-			boost::multi_index::indexed_by<
-				boost::multi_index::hashed_unique<boost::multi_index::key<&Child::output>>,
-				boost::multi_index::hashed_unique<boost::multi_index::key<&Child::input>>
-			>
-		>;
+		struct InputHash
+		{
+			size_t operator()( const Input &input ) const;
+		};
 
-		Map m_map;
+		// Maps from output name to index in `m_childNames`.
+		std::unordered_map<IECore::InternedString, size_t, InternedStringHash> m_outputIndices;
+		// Maps from input to output name, but only for inputs which
+		// have been renamed. This is typically much smaller than the
+		// number of children.
+		std::unordered_map<Input, IECore::InternedString, InputHash> m_renamed;
 
 };
 
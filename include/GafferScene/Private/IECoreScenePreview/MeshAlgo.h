@@ -36,6 +36,7 @@
 
 #include "GafferScene/Export.h"
 
+#include "IECoreScene/CurvesPrimitive.h"
 #include "IECoreScene/MeshPrimitive.h"
 #include "IECore/Canceller.h"
 
@@ -54,6 +55,17 @@ GAFFERSCENE_API IECoreScene::MeshPrimitivePtr tessellateMesh(
 	const IECore::Canceller *canceller = nullptr
 );
 
+/// Multithreaded equivalents of the IECoreScene::MeshAlgo functions of the
+/// same name, producing identical results. Faces are processed in parallel,
+/// and the canceller is checked periodically by each task.
+/// \todo Contribute these back to Cortex.
+GAFFERSCENE_API void reverseWinding( IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+GAFFERSCENE_API IECoreScene::PrimitiveVariable calculateUniformNormals( const IECoreScene::MeshPrimitive *mesh, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
+
+/// Returns a CurvesPrimitive with a linear curve for each unique edge of the mesh,
+/// positioned using the specified Vertex, Varying or FaceVarying primitive variable.
+GAFFERSCENE_API IECoreScene::CurvesPrimitivePtr wireframe( const IECoreScene::MeshPrimitive *mesh, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
+
 } // namespace MeshAlgo
 
 } // namespace IECoreScenePreview
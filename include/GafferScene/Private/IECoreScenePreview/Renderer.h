@@ -300,6 +300,32 @@ class GAFFERSCENE_API Renderer : public IECore::RefCounted
 		/// As above, but specifying a deforming object.
 		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) = 0;
 
+		/// Describes an object to be added to the render via `objects()`.
+		struct ObjectDescription
+		{
+			std::string name;
+			/// A single sample and no times for a static object, or one
+			/// sample per time in `sampleTimes` for a deforming object.
+			std::vector<const IECore::Object *> samples;
+			std::vector<float> sampleTimes;
+			const AttributesInterface *attributes = nullptr;
+			/// As above, but for the transform. No transform is
+			/// assigned if `transformSamples` is empty.
+			std::vector<Imath::M44f> transformSamples;
+			std::vector<float> transformTimes;
+			/// Pairs of link type and objects, as passed to `ObjectInterface::link()`.
+			std::vector<std::pair<IECore::InternedString, ConstObjectSetPtr>> links;
+		};
+
+		/// Adds many objects to the render in a single call. This is equivalent
+		/// to calling `object()` for each description and then assigning
+		/// the transform and links, but allows renderers to amortise locking
+		/// and other per-object overheads across the whole batch. On return,
+		/// `result` contains the handle for each description, or nullptr if
+		/// the object is not supported by the renderer. The default implementation
+		/// calls `object()` for each description in parallel.
+		virtual void objects( const std::vector<ObjectDescription> &objects, std::vector<ObjectInterfacePtr> &result );
+
 		/// Performs the render - should be called after the
 		/// entire scene has been specified using the methods
 		/// above. Batch and SceneDescripton renders will have
@@ -209,12 +209,16 @@ class GAFFERSCENE_API LightLinks : boost::noncopyable
 		/// Outputs light links for the specified location. May be called concurrently
 		/// with respect to itself, but not other methods. The optional `hash` pointer
 		/// should be unique to `object`, and will be used to optimise subsequent calls
-		/// for the same object.
+		/// for the same object, avoiding relinking when the lights it is linked to
+		/// have not changed.
 		/// > Note : `hash` is an awkward implementation detail used to allow
 		/// > LightLinks to store some state in RenderController's scene graphs.
 		/// > The alternative would be to register all objects with LightLinks,
 		/// > but then we would have duplicate storage structures for the entire scene.
 		void outputLightLinks( const ScenePlug *scene, const IECore::CompoundObject *attributes, IECoreScenePreview::Renderer::ObjectInterface *object, IECore::MurmurHash *hash = nullptr ) const;
+		/// As above, but appending the links to `description` instead of outputting
+		/// them directly, for use with `Renderer::objects()`.
+		void outputLightLinks( const ScenePlug *scene, const IECore::CompoundObject *attributes, IECoreScenePreview::Renderer::ObjectDescription &description ) const;
 		/// Outputs all light filter links at once.
 		void outputLightFilterLinks( const ScenePlug *scene );
 
@@ -244,6 +248,7 @@ class GAFFERSCENE_API LightLinks : boost::noncopyable
 		void removeFilterLink( const IECoreScenePreview::Renderer::ObjectInterfacePtr &lightFilter, const std::string &filteredLightsExpression );
 		std::string filteredLightsExpression( const IECore::CompoundObject *attributes ) const;
 		IECoreScenePreview::Renderer::ConstObjectSetPtr linkedLights( const std::string &linkedLightsExpression, const ScenePlug *scene ) const;
+		void linkedLights( const ScenePlug *scene, const IECore::CompoundObject *attributes, IECoreScenePreview::Renderer::ConstObjectSetPtr &lights, IECoreScenePreview::Renderer::ConstObjectSetPtr &shadowedLights ) const;
 		void outputLightFilterLinks( const std::string &lightName, IECoreScenePreview::Renderer::ObjectInterface *light ) const;
 		void clearLightLinks();
 
@@ -263,12 +268,38 @@ class GAFFERSCENE_API LightLinks : boost::noncopyable
 		/// ===========================
 		///
 		/// This maps from `linkedLights` expressions to ObjectSets containing
-		/// the relevant lights.
+		/// the relevant lights. Many objects share the same expression, so this
+		/// table effectively compresses the links for the whole scene.
 
-		using LightLinkMap = tbb::concurrent_hash_map<std::string, IECoreScenePreview::Renderer::ObjectSetPtr>;
+		struct LightLink
+		{
+			// Result of `SetAlgo::setExpressionHash()` at the time
+			// `lights` was computed.
+			IECore::MurmurHash setsHash;
+			IECoreScenePreview::Renderer::ObjectSetPtr lights;
+			// True if the sets have been dirtied since `lights`
+			// was computed, meaning that `setsHash` must be checked
+			// before reusing it.
+			bool setsDirty;
+		};
+
+		using LightLinkMap = tbb::concurrent_hash_map<std::string, LightLink>;
 		mutable LightLinkMap m_lightLinks;
 		tbb::spin_mutex m_lightLinksClearMutex;
 
+		/// Different expressions frequently resolve to the same lights, so we
+		/// deduplicate the ObjectSets by their contents. This reduces memory
+		/// usage, and means that renderers which allocate resources per unique
+		/// set (for instance, light groups) need allocate fewer of them. Because
+		/// this map owns the sets, the set pointers are unique within each
+		/// generation, and can be used to detect when relinking is necessary.
+		using UniqueLightSetMap = tbb::concurrent_hash_map<IECore::MurmurHash, IECoreScenePreview::Renderer::ObjectSetPtr>;
+		mutable UniqueLightSetMap m_uniqueLightSets;
+		/// Incremented whenever the above maps are cleared.
+		std::atomic_uint64_t m_lightLinksGeneration;
+
+		IECoreScenePreview::Renderer::ObjectSetPtr uniqueLightSet( const IECoreScenePreview::Renderer::ObjectSetPtr &lights ) const;
+
 		/// Storage for links between lights and light filters
 		/// ==================================================
 		///
@@ -82,6 +82,20 @@ class GAFFERSCENE_API RenderController : public Gaffer::Signals::Trackable
 		void setMinimumExpansionDepth( size_t depth );
 		size_t getMinimumExpansionDepth() const;
 
+		// Prioritisation
+		// ==============
+		//
+		// When non-zero, `updateInBackground()` first updates all locations
+		// whose bounds cover at least this fraction of the area of the render
+		// camera's screen window, before updating the rest of the scene.
+		// Only locations included by the VisibleSet are considered. This allows
+		// the most significant parts of a large scene to be rendered first.
+		// Defaults to 0, meaning that no camera-based prioritisation is
+		// performed.
+
+		void setCameraPriorityThreshold( float threshold );
+		float getCameraPriorityThreshold() const;
+
 		// Update
 		// ======
 
@@ -138,6 +152,7 @@ class GAFFERSCENE_API RenderController : public Gaffer::Signals::Trackable
 		void updateInternal( const ProgressCallback &callback = ProgressCallback(), const IECore::PathMatcher *pathsToUpdate = nullptr, bool signalCompletion = true );
 		void updateDefaultCamera();
 		void cancelBackgroundTask();
+		IECore::PathMatcher cameraPriorityPaths( float threshold ) const;
 
 		class SceneGraph;
 
@@ -148,6 +163,7 @@ class GAFFERSCENE_API RenderController : public Gaffer::Signals::Trackable
 
 		GafferScene::VisibleSet m_visibleSet;
 		size_t m_minimumExpansionDepth;
+		float m_cameraPriorityThreshold;
 
 		Gaffer::Signals::ScopedConnection m_plugDirtiedConnection;
 		Gaffer::Signals::ScopedConnection m_contextChangedConnection;
@@ -2396,6 +2396,94 @@ class RendererTest( GafferTest.TestCase ) :
 				name = name.replace( "cycles:integrator:", "" )
 				self.assertEqual( film[name], defaults[name] )
 
+	def testQueryStatistics( self ) :
+
+		renderer = self.createRenderer()
+
+		statistics = renderer.command( "cycles:queryStatistics", {} )
+		self.assertEqual(
+			set( statistics.keys() ),
+			{ "sceneLockAcquisitions", "sceneLockWaitTime", "sceneLockHoldTime", "geometryConversionTime" }
+		)
+		self.assertIsInstance( statistics["sceneLockAcquisitions"], IECore.UInt64Data )
+		for name in ( "sceneLockWaitTime", "sceneLockHoldTime", "geometryConversionTime" ) :
+			with self.subTest( name = name ) :
+				self.assertIsInstance( statistics[name], IECore.DoubleData )
+				self.assertGreaterEqual( statistics[name].value, 0 )
+
+		def assertStatisticsChanged( before, after, elapsed, minAcquisitions ) :
+
+			# Each new object needs at least `minAcquisitions` of the scene lock.
+			# The renderer is only being used from this thread, so the time spent
+			# waiting for and holding the lock can't exceed the time taken by the
+			# call itself, and neither can the time spent converting geometry.
+
+			self.assertGreaterEqual(
+				after["sceneLockAcquisitions"].value - before["sceneLockAcquisitions"].value,
+				minAcquisitions
+			)
+			self.assertLessEqual(
+				( after["sceneLockWaitTime"].value - before["sceneLockWaitTime"].value ) +
+				( after["sceneLockHoldTime"].value - before["sceneLockHoldTime"].value ),
+				elapsed
+			)
+			self.assertGreaterEqual( after["sceneLockHoldTime"].value, before["sceneLockHoldTime"].value )
+			self.assertLessEqual(
+				after["geometryConversionTime"].value - before["geometryConversionTime"].value,
+				elapsed
+			)
+
+		# Objects need the lock to create their geometry node, to create their
+		# object node and to assign the geometry to the object.
+
+		startTime = time.perf_counter()
+		sphere = renderer.object(
+			"/sphere",
+			IECoreScene.SpherePrimitive(),
+			renderer.attributes( IECore.CompoundObject() )
+		)
+		elapsed = time.perf_counter() - startTime
+
+		statistics2 = renderer.command( "cycles:queryStatistics", {} )
+		assertStatisticsChanged( statistics, statistics2, elapsed, 3 )
+		self.assertGreater( statistics2["geometryConversionTime"].value, statistics["geometryConversionTime"].value )
+
+		startTime = time.perf_counter()
+		mesh = renderer.object(
+			"/plane",
+			IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) ),
+			renderer.attributes( IECore.CompoundObject() )
+		)
+		elapsed = time.perf_counter() - startTime
+
+		statistics3 = renderer.command( "cycles:queryStatistics", {} )
+		assertStatisticsChanged( statistics2, statistics3, elapsed, 3 )
+		self.assertGreater( statistics3["geometryConversionTime"].value, statistics2["geometryConversionTime"].value )
+
+		# Lights need the lock to create their light and object nodes, but
+		# don't involve any geometry conversion.
+
+		startTime = time.perf_counter()
+		light = renderer.light( "/light", None, renderer.attributes( IECore.CompoundObject() ) )
+		elapsed = time.perf_counter() - startTime
+
+		statistics4 = renderer.command( "cycles:queryStatistics", {} )
+		assertStatisticsChanged( statistics3, statistics4, elapsed, 2 )
+		self.assertEqual( statistics4["geometryConversionTime"].value, statistics3["geometryConversionTime"].value )
+
+		# Moving an object needs the lock to tag it for update.
+
+		startTime = time.perf_counter()
+		sphere.transform( imath.M44f().translate( imath.V3f( 1, 0, 0 ) ) )
+		elapsed = time.perf_counter() - startTime
+
+		statistics5 = renderer.command( "cycles:queryStatistics", {} )
+		assertStatisticsChanged( statistics4, statistics5, elapsed, 1 )
+
+		del sphere, mesh, light
+
+		del renderer
+
 	def testUnknownOptions( self ) :
 
 		renderer = self.createRenderer()
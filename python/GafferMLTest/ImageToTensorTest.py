@@ -148,6 +148,39 @@ class ImageToTensorTest( GafferTest.TestCase ) :
 		for i in range( 0, 3 ) :
 			self.assertAlmostEqual( imageToTensor["tensor"].getValue().asData()[i], color[i], delta = 0.005 )
 
+	def testPlanarMatchesInterleaved( self ) :
+
+		# Planar channels are converted a row at a time, and interleaved
+		# channels an element at a time. Both must produce the same values.
+
+		checker = GafferImage.Checkerboard()
+		checker["format"].setValue( GafferImage.Format( imath.Box2i( imath.V2i( -10, 5 ), imath.V2i( 90, 75 ) ) ) )
+		checker["size"].setValue( imath.V2f( 7 ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( checker["out"] )
+		grade["channels"].setValue( "R" )
+		grade["multiply"].setValue( imath.Color4f( 0.25 ) )
+
+		imageToTensor = GafferML.ImageToTensor()
+		imageToTensor["image"].setInput( grade["out"] )
+
+		planar = imageToTensor["tensor"].getValue()
+		imageToTensor["interleaveChannels"].setValue( True )
+		interleaved = imageToTensor["tensor"].getValue()
+
+		self.assertEqual( planar.shape(), [ 3, 70, 100 ] )
+		self.assertEqual( interleaved.shape(), [ 70, 100, 3 ] )
+
+		planarData = list( planar.asData() )
+		interleavedData = list( interleaved.asData() )
+		numPixels = 70 * 100
+		for c in range( 0, 3 ) :
+			self.assertEqual(
+				planarData[c*numPixels:(c+1)*numPixels],
+				interleavedData[c::3]
+			)
+
 
 if __name__ == "__main__":
 	unittest.main()
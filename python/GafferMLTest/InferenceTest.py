@@ -39,6 +39,8 @@ import subprocess
 import pathlib
 import unittest
 
+import imath
+
 import IECore
 
 import Gaffer
@@ -103,6 +105,125 @@ class InferenceTest( GafferTest.TestCase ) :
 			IECore.FloatVectorData( [ 4 ] * 60 )
 		)
 
+	def testTiling( self ) :
+
+		inference = GafferML.Inference()
+		inference["model"].setValue( pathlib.Path( __file__ ).parent / "models" / "add.onnx" )
+		inference.loadModel()
+
+		# The model has fixed input dimensions of `[ 3, 4, 5 ]`, so without tiling
+		# it can't process larger inputs.
+
+		size = 3 * 8 * 10
+		inference["in"][0].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( range( 0, size ) ), [ 3, 8, 10 ] )
+		)
+		inference["in"][1].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( range( 0, size * 10, 10 ) ), [ 3, 8, 10 ] )
+		)
+
+		with self.assertRaisesRegex( Gaffer.ProcessException, "Got invalid dimensions for input" ) :
+			inference["out"][0].getValue()
+
+		# But with tiles padded to exactly match the model dimensions, we can
+		# process any size. This includes tiles at the edges, which are
+		# shifted inwards to keep their size constant.
+
+		inference["tileSize"].setValue( imath.V2i( 3, 2 ) )
+		inference["tilePadding"].setValue( 1 )
+
+		tensor = inference["out"][0].getValue()
+		self.assertEqual( tensor.shape(), [ 3, 8, 10 ] )
+		self.assertEqual( tensor.asData(), IECore.FloatVectorData( range( 0, size * 11, 11 ) ) )
+
+		# Tiling with mismatched window sizes errors.
+
+		inference["tilePadding"].setValue( 0 )
+		with self.assertRaisesRegex( Gaffer.ProcessException, "Got invalid dimensions for input" ) :
+			inference["out"][0].getValue()
+
+	def testTilingRejectsInterleavedChannels( self ) :
+
+		inference = GafferML.Inference()
+		inference["model"].setValue( pathlib.Path( __file__ ).parent / "models" / "add.onnx" )
+		inference.loadModel()
+
+		# Interleaved tensors, as produced by `ImageToTensor.interleaveChannels`,
+		# have channels as the last dimension, so can't be tiled as if the last
+		# two dimensions were rows and columns.
+
+		for i in range( 0, 2 ) :
+			inference["in"][i].setValue(
+				GafferML.Tensor( IECore.FloatVectorData( [ 1 ] * 8 * 10 * 3 ), [ 1, 8, 10, 3 ] )
+			)
+
+		inference["tileSize"].setValue( imath.V2i( 4 ) )
+		with self.assertRaisesRegex( Gaffer.ProcessException, "Tiled inference requires planar \\(NCHW\\) inputs" ) :
+			inference["out"][0].getValue()
+
+	def testTiledComputeMatchesUntiled( self ) :
+
+		inference = GafferML.Inference()
+		inference["model"].setValue( pathlib.Path( __file__ ).parent / "models" / "add.onnx" )
+		inference.loadModel()
+
+		inference["in"][0].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( range( 0, 60 ) ), [ 3, 4, 5 ] )
+		)
+		inference["in"][1].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( [ 2 ] * 60 ), [ 3, 4, 5 ] )
+		)
+
+		untiled = inference["out"][0].getValue()
+		untiledHash = inference["out"][0].hash()
+
+		inference["tileSize"].setValue( imath.V2i( 8 ) )
+		self.assertNotEqual( inference["out"][0].hash(), untiledHash )
+		self.assertEqual( inference["out"][0].getValue().asData(), untiled.asData() )
+
+		inference["tileSize"].setValue( imath.V2i( 0 ) )
+		inference["tilePadding"].setValue( 2 )
+		self.assertEqual( inference["out"][0].hash(), untiledHash )
+
+	def testPreallocatedOutputs( self ) :
+
+		# The model has a static output shape, so outputs are written directly
+		# into buffers allocated by the node. Results must match those computed
+		# by ONNX itself, and must not share buffers between computes.
+
+		inference = GafferML.Inference()
+		inference["model"].setValue( pathlib.Path( __file__ ).parent / "models" / "add.onnx" )
+		inference.loadModel()
+
+		inference["in"][0].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( range( 0, 60 ) ), [ 3, 4, 5 ] )
+		)
+		inference["in"][1].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( [ 2 ] * 60 ), [ 3, 4, 5 ] )
+		)
+
+		tensor1 = inference["out"][0].getValue()
+		self.assertEqual( tensor1.shape(), [ 3, 4, 5 ] )
+		self.assertEqual( tensor1.asData(), IECore.FloatVectorData( [ x + 2 for x in range( 0, 60 ) ] ) )
+		self.assertGreaterEqual( tensor1.memoryUsage(), 60 * 4 )
+
+		inference["in"][1].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( [ 5 ] * 60 ), [ 3, 4, 5 ] )
+		)
+
+		tensor2 = inference["out"][0].getValue()
+		self.assertEqual( tensor2.asData(), IECore.FloatVectorData( [ x + 5 for x in range( 0, 60 ) ] ) )
+		self.assertEqual( tensor1.asData(), IECore.FloatVectorData( [ x + 2 for x in range( 0, 60 ) ] ) )
+
+		# The tiled path always uses preallocated outputs, and must match
+		# the untiled result.
+
+		inference["tileSize"].setValue( imath.V2i( 3, 2 ) )
+		inference["tilePadding"].setValue( 1 )
+		tensor3 = inference["out"][0].getValue()
+		self.assertEqual( tensor3.shape(), tensor2.shape() )
+		self.assertEqual( tensor3.asData(), tensor2.asData() )
+
 	def testComputeError( self ) :
 
 		inference = GafferML.Inference()
@@ -145,6 +266,37 @@ class InferenceTest( GafferTest.TestCase ) :
 			self.assertEqual( len( node["in"] ), 2 )
 			self.assertEqual( len( node["out"] ), 1 )
 
+	def testOptimizedModelCache( self ) :
+
+		cacheDirectory = self.temporaryDirectory() / "optimizedModels"
+
+		env = Gaffer.environment()
+		env["GAFFERML_OPTIMIZED_MODEL_CACHE"] = str( cacheDirectory )
+
+		def runTest() :
+
+			try :
+				subprocess.check_output(
+					[ str( Gaffer.executablePath() ), "test", "GafferMLTest.InferenceTest.testCompute" ],
+					env = env, stderr = subprocess.STDOUT
+				)
+			except subprocess.CalledProcessError as e :
+				self.fail( e.output )
+
+		# First run populates the cache.
+
+		runTest()
+		cachedModels = list( cacheDirectory.glob( "*" ) )
+		self.assertEqual( len( cachedModels ), 1 )
+		self.assertEqual( cachedModels[0].suffix, ".onnx" )
+		modificationTime = cachedModels[0].stat().st_mtime
+
+		# Second run loads from it, giving the same results.
+
+		runTest()
+		self.assertEqual( list( cacheDirectory.glob( "*" ) ), cachedModels )
+		self.assertEqual( cachedModels[0].stat().st_mtime, modificationTime )
+
 	def testLoadModelKeepsConnections( self ) :
 
 		dataToTensor1 = GafferML.DataToTensor()
@@ -170,6 +170,34 @@ class TensorToImageTest( GafferImageTest.ImageTestCase ) :
 			imageToTensor["tensorElementType"].setValue( t )
 			self.assertImagesEqual( tensorToImage["out"], image["out"], maxDifference = 5e-4 )
 
+	def testPlanarMatchesInterleaved( self ) :
+
+		# Planar channels are converted a row at a time, and interleaved
+		# channels an element at a time. Both must produce the same image.
+
+		width = 100
+		height = 70
+		numPixels = width * height
+
+		planar = GafferML.TensorToImage()
+		planar["tensor"].setValue(
+			GafferML.Tensor( IECore.FloatVectorData( [ x * 0.5 for x in range( 0, numPixels * 3 ) ] ), [ 3, height, width ] )
+		)
+
+		interleavedData = IECore.FloatVectorData()
+		for i in range( 0, numPixels ) :
+			for c in range( 0, 3 ) :
+				interleavedData.append( ( c * numPixels + i ) * 0.5 )
+
+		interleaved = GafferML.TensorToImage()
+		interleaved["interleavedChannels"].setValue( True )
+		interleaved["tensor"].setValue(
+			GafferML.Tensor( interleavedData, [ height, width, 3 ] )
+		)
+
+		self.assertEqual( planar["out"].dataWindow(), imath.Box2i( imath.V2i( 0 ), imath.V2i( width, height ) ) )
+		self.assertImagesEqual( planar["out"], interleaved["out"] )
+
 
 if __name__ == "__main__":
 	unittest.main()
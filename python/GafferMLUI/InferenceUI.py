@@ -108,6 +108,46 @@ Gaffer.Metadata.registerNode(
 
 		},
 
+		"tileSize" : {
+
+			"description" :
+			"""
+			Splits the inputs into tiles of this size, and runs the model
+			separately on each tile, in parallel. This reduces the memory
+			needed to process large images, and allows models with fixed
+			input dimensions to be applied to images of any size. Tiling is
+			applied to the last two dimensions of each input, which must
+			be rows and columns. Inputs must therefore be planar tensors
+			with NCHW layout, as produced by ImageToTensor with
+			`interleaveChannels` off. Inputs which appear to have
+			interleaved (NHWC) channels are rejected with an error. A value
+			of `0` disables tiling in that dimension.
+
+			> Note : Inputs whose last two dimensions don't match the first
+			> image input are passed to each tile unchanged.
+			""",
+
+			"layout:section" : "Tiling",
+			"nodule:type" : "",
+
+		},
+
+		"tilePadding" : {
+
+			"description" :
+			"""
+			The number of additional pixels on each side of a tile that are
+			passed to the model, to provide the context needed to produce
+			seamless results. Only the unpadded centre of each tile is used
+			in the output, so the padding should be at least as large as the
+			model's receptive field.
+			""",
+
+			"layout:section" : "Tiling",
+			"nodule:type" : "",
+
+		},
+
 	}
 )
 
@@ -852,6 +852,58 @@ class OSLImageTest( GafferImageTest.ImageTestCase ) :
 		with GafferTest.TestRunner.PerformanceScope() :
 			GafferImage.ImageAlgo.image( resize["out"] )
 
+	def __mandelbrotImage( self, size, iterations ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( size, size ) )
+
+		mandelbrotCode = self.mandelbrotNode()
+		mandelbrotCode["parameters"]["iterations"].setValue( iterations )
+
+		oslImage = GafferOSL.OSLImage()
+		oslImage["in"].setInput( constant["out"] )
+		oslImage["channels"].addChild( Gaffer.NameValuePlug( "R", Gaffer.FloatPlug( "value" ), True, "channel" ) )
+		oslImage["channels"]["channel"]["value"].setInput( mandelbrotCode["out"]["outFloat"] )
+
+		return constant, mandelbrotCode, oslImage
+
+	def testUseBatchedShading( self ) :
+
+		constant, mandelbrotCode, oslImage = self.__mandelbrotImage( 128, 100 )
+		self.assertEqual( oslImage["useBatchedShading"].getValue(), True )
+
+		batchedHash = oslImage["out"].channelDataHash( "R", imath.V2i( 0 ) )
+		batchedImage = GafferImage.ImageAlgo.image( oslImage["out"] )
+
+		oslImage["useBatchedShading"].setValue( False )
+		self.assertNotEqual( oslImage["out"].channelDataHash( "R", imath.V2i( 0 ) ), batchedHash )
+		nonBatchedImage = GafferImage.ImageAlgo.image( oslImage["out"] )
+
+		# Batched and non-batched shading may use different implementations of
+		# functions like `pow()`, so we allow for tiny differences.
+		self.assertEqual( batchedImage.keys(), nonBatchedImage.keys() )
+		for a, b in zip( batchedImage["R"], nonBatchedImage["R"] ) :
+			self.assertAlmostEqual( a, b, places = 5 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testBatchedShadingPerf( self ) :
+
+		constant, mandelbrotCode, oslImage = self.__mandelbrotImage( 1024, 500 )
+		GafferImage.ImageAlgo.image( constant["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImage.ImageAlgo.image( oslImage["out"] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testNonBatchedShadingPerf( self ) :
+
+		constant, mandelbrotCode, oslImage = self.__mandelbrotImage( 1024, 500 )
+		oslImage["useBatchedShading"].setValue( False )
+		GafferImage.ImageAlgo.image( constant["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImage.ImageAlgo.image( oslImage["out"] )
+
 	def testOSLSplineMatch( self ):
 
 		g = GafferOSL.OSLShader()
@@ -461,6 +461,65 @@ class OSLObjectTest( GafferOSLTest.OSLTestCase ) :
 			IECore.V3fVectorData( [imath.V3f( 4, 5, 6 ), imath.V3f( 1, 2, 3 )] * 2048, IECore.GeometricData.Interpretation.Point ) )
 		self.assertEqual( processedPoints["P"].indices, None )
 
+	def testCanShadeIndexedStringAndColorPrimVars( self ) :
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 4096 ) ] ) )
+		points["color"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.Color3fVectorData( [ imath.Color3f( 1, 0, 0 ), imath.Color3f( 0, 1, 0 ), imath.Color3f( 0, 0, 1 ) ] ),
+			IECore.IntVectorData( [ i % 3 for i in range( 0, 4096 ) ] )
+		)
+		points["name"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.StringVectorData( [ "a", "b" ] ),
+			IECore.IntVectorData( [ i % 2 for i in range( 0, 4096 ) ] )
+		)
+		self.assertTrue( points.arePrimitiveVariablesValid() )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		inColor = GafferOSL.OSLShader( "InColor" )
+		inColor.loadShader( "ObjectProcessing/InColor" )
+		inColor["parameters"]["name"].setValue( "color" )
+
+		outColor = GafferOSL.OSLShader( "OutColor" )
+		outColor.loadShader( "ObjectProcessing/OutColor" )
+		outColor["parameters"]["name"].setValue( "shadedColor" )
+		outColor["parameters"]["value"].setInput( inColor["out"]["value"] )
+
+		inString = GafferOSL.OSLShader( "InString" )
+		inString.loadShader( "ObjectProcessing/InString" )
+		inString["parameters"]["name"].setValue( "name" )
+
+		outString = GafferOSL.OSLShader( "OutString" )
+		outString.loadShader( "ObjectProcessing/OutString" )
+		outString["parameters"]["name"].setValue( "shadedName" )
+		outString["parameters"]["value"].setInput( inString["out"]["value"] )
+
+		outObject = GafferOSL.OSLShader( "OutObject" )
+		outObject.loadShader( "ObjectProcessing/OutObject" )
+		outObject["parameters"]["in0"].setInput( outColor["out"]["primitiveVariable"] )
+		outObject["parameters"]["in1"].setInput( outString["out"]["primitiveVariable"] )
+
+		oslObject = GafferOSL.OSLObject()
+		oslObject["in"].setInput( objectToScene["out"] )
+		oslObject["filter"].setInput( filter["out"] )
+		oslObject["shader"].setInput( outObject["out"]["out"] )
+
+		processedPoints = oslObject["out"].object( "/object" )
+
+		self.assertEqual( processedPoints["shadedColor"].data, points["color"].expandedData() )
+		self.assertEqual( processedPoints["shadedName"].data, points["name"].expandedData() )
+
+		# The input variables should be passed through untouched.
+
+		self.assertEqual( processedPoints["color"], points["color"] )
+		self.assertEqual( processedPoints["name"], points["name"] )
+
 	def testTextureOrientation( self ) :
 
 		textureFileName = pathlib.Path( __file__ ).parent / "images" / "vRamp.tx"
@@ -1087,6 +1146,74 @@ class OSLObjectTest( GafferOSLTest.OSLTestCase ) :
 
 		self.assertEqual( o["out"].object( "/plane" )["test"].data, IECore.IntVectorData( [ 10 ] * 10000 ) )
 
+	def __noisePlane( self, divisions ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( divisions ) )
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		code = GafferOSL.OSLCode()
+		code["out"].addChild( Gaffer.Color3fPlug( "c", direction = Gaffer.Plug.Direction.Out ) )
+		code["out"].addChild( Gaffer.StringPlug( "s", direction = Gaffer.Plug.Direction.Out ) )
+		code["code"].setValue( inspect.cleandoc(
+			"""
+			c = 0;
+			for( int i = 0; i < 20; ++i )
+			{
+				c += noise( "perlin", P * ( i + 1 ) ) / ( i + 1 );
+			}
+			s = c[0] > 0.5 ? "high" : "low";
+			"""
+		) )
+
+		oslObject = GafferOSL.OSLObject()
+		oslObject["in"].setInput( plane["out"] )
+		oslObject["filter"].setInput( planeFilter["out"] )
+		oslObject["primitiveVariables"].addChild( Gaffer.NameValuePlug( "c", Gaffer.Color3fPlug( "value" ), True, "c" ) )
+		oslObject["primitiveVariables"]["c"]["value"].setInput( code["out"]["c"] )
+		oslObject["primitiveVariables"].addChild( Gaffer.NameValuePlug( "s", Gaffer.StringPlug( "value" ), True, "s" ) )
+		oslObject["primitiveVariables"]["s"]["value"].setInput( code["out"]["s"] )
+
+		return plane, planeFilter, code, oslObject
+
+	def testUseBatchedShading( self ) :
+
+		plane, planeFilter, code, oslObject = self.__noisePlane( 50 )
+		self.assertEqual( oslObject["useBatchedShading"].getValue(), True )
+
+		batchedHash = oslObject["out"].objectHash( "/plane" )
+		batched = oslObject["out"].object( "/plane" )
+
+		oslObject["useBatchedShading"].setValue( False )
+		self.assertNotEqual( oslObject["out"].objectHash( "/plane" ), batchedHash )
+		nonBatched = oslObject["out"].object( "/plane" )
+
+		self.assertEqual( batched["s"], nonBatched["s"] )
+		for a, b in zip( batched["c"].data, nonBatched["c"].data ) :
+			for i in range( 0, 3 ) :
+				self.assertAlmostEqual( a[i], b[i], places = 5 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testBatchedShadingPerf( self ) :
+
+		plane, planeFilter, code, oslObject = self.__noisePlane( 1000 )
+		oslObject["in"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			oslObject["out"].object( "/plane" )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testNonBatchedShadingPerf( self ) :
+
+		plane, planeFilter, code, oslObject = self.__noisePlane( 1000 )
+		oslObject["useBatchedShading"].setValue( False )
+		oslObject["in"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			oslObject["out"].object( "/plane" )
+
 	def testAffects( self ) :
 
 		s = GafferScene.Sphere()
@@ -45,6 +45,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferOSL
 import GafferOSLTest
 
@@ -693,6 +694,30 @@ class ShadingEngineTest( GafferOSLTest.OSLTestCase ) :
 				imath.Color3f( f, f, f )
 			)
 
+	def testUseBatchedShading( self ) :
+
+		s = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "stringAttribute.osl" )
+		e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+			shaders = {
+				"output" : IECoreScene.Shader( s, "osl:surface", { "name" : "strattr" } )
+			},
+			output = "output"
+		) )
+
+		p = self.rectanglePoints()
+		p["strattr"] = IECore.StringVectorData( [ "testo" if i % 2 == 0 else "no-testo" for i in range(len(p["P"])) ] )
+
+		# Strings are represented differently by OSL for batched and non-batched
+		# shading, so alternate between the two to check we convert them correctly
+		# in each case.
+
+		for useBatchedShading in ( True, False, True, False ) :
+
+			r = e.shade( p, useBatchedShading = useBatchedShading )
+			for i, c in enumerate( r["Ci"] ) :
+				f = 1.0 if i % 2 == 0 else 0.0
+				self.assertEqual( c, imath.Color3f( f, f, f ) )
+
 	def testUVProvidedAsV2f( self ) :
 
 		shader = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "globals.osl" )
@@ -717,6 +742,68 @@ class ShadingEngineTest( GafferOSLTest.OSLTestCase ) :
 			for i, c in enumerate( p["Ci"] ) :
 				self.assertEqual( c, imath.Color3f( rp["uv"][i][uvIndex] ) )
 
+	def testIndexedUserData( self ) :
+
+		shader = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "attribute.osl" )
+		stringShader = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "stringAttribute.osl" )
+
+		p = self.rectanglePoints()
+		numPoints = len( p["P"] )
+		p["indexedColor"] = IECore.Color3fVectorData( [ imath.Color3f( 1, 0, 0 ), imath.Color3f( 0, 1, 0 ), imath.Color3f( 0, 0, 1 ) ] )
+		p["indexedString"] = IECore.StringVectorData( [ "no-testo", "testo" ] )
+
+		indices = {
+			"indexedColor" : IECore.IntVectorData( [ i % 3 for i in range( 0, numPoints ) ] ),
+			"indexedString" : IECore.IntVectorData( [ 1 if i % 2 == 0 else 0 for i in range( 0, numPoints ) ] ),
+		}
+
+		e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+			shaders = {
+				"output" : IECoreScene.Shader( shader, "osl:surface", { "name" : "indexedColor" } ),
+			},
+			output = "output"
+		) )
+
+		r = e.shade( p, indices = indices )
+		for i, c in enumerate( r["Ci"] ) :
+			self.assertEqual( c, p["indexedColor"][indices["indexedColor"][i]] )
+
+		e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+			shaders = {
+				"output" : IECoreScene.Shader( stringShader, "osl:surface", { "name" : "indexedString" } )
+			},
+			output = "output"
+		) )
+
+		r = e.shade( p, indices = indices )
+		for i, c in enumerate( r["Ci"] ) :
+			self.assertEqual( c, imath.Color3f( 1.0 if i % 2 == 0 else 0.0 ) )
+
+	def testIndexedGlobals( self ) :
+
+		shader = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "globals.osl" )
+
+		rp = self.rectanglePoints()
+		numPoints = len( rp["P"] )
+		rp["uv"] = IECore.V2fVectorData( [ imath.V2f( 0.25, 0.5 ), imath.V2f( 0.75, 1 ) ] )
+		del rp["u"]
+		del rp["v"]
+
+		uvIndices = IECore.IntVectorData( [ i % 2 for i in range( 0, numPoints ) ] )
+
+		for uvIndex, uvName in enumerate( [ "u", "v" ] ) :
+
+			e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+				shaders = {
+					"output" : IECoreScene.Shader( shader, "osl:surface", { "global" : uvName } ),
+				},
+				output = "output"
+			) )
+
+			p = e.shade( rp, indices = { "uv" : uvIndices } )
+			for i, c in enumerate( p["Ci"] ) :
+				self.assertEqual( c, imath.Color3f( rp["uv"][uvIndices[i]][uvIndex] ) )
+
 	def testTextureOrientation( self ) :
 
 		s = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "uvTextureMap.osl" )
@@ -1233,5 +1320,82 @@ class ShadingEngineTest( GafferOSLTest.OSLTestCase ) :
 			self.assertEqual( len( results["Ci"] ), 1 )
 			self.assertEqual( results["Ci"][0][0], 0 )
 
+	def testEnginesWithIdenticalNetworks( self ) :
+
+		inputClosureShader = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "inputClosure.osl" )
+
+		def network( name ) :
+
+			return IECoreScene.ShaderNetwork(
+				shaders = {
+					"outPoint" : IECoreScene.Shader(
+						"ObjectProcessing/OutPoint", "osl:shader",
+						{
+							"name" : name
+						}
+					),
+					"output" : IECoreScene.Shader( inputClosureShader, "osl:surface" ),
+				},
+				connections = [
+					( ( "outPoint", "primitiveVariable" ), ( "output", "i" ) ),
+				],
+				output = "output"
+			)
+
+		# Engines constructed from identical networks share a compiled
+		# shader group, but must still behave as if they were independent.
+
+		e1 = GafferOSL.ShadingEngine( network( "P" ) )
+		e2 = GafferOSL.ShadingEngine( network( "P" ) )
+		e3 = GafferOSL.ShadingEngine( network( "notP" ) )
+
+		self.assertTrue( e1.hasDeformation() )
+		self.assertTrue( e2.hasDeformation() )
+		self.assertFalse( e3.hasDeformation() )
+
+		points = self.rectanglePoints()
+		self.assertEqual( e1.shade( points ), e2.shade( points ) )
+
+		# Shading must remain valid after the other engines
+		# sharing the group have been destroyed.
+
+		expected = e1.shade( points )
+		del e1
+		self.assertEqual( e2.shade( points ), expected )
+
+	def testInvalidShadersWithIdenticalNetworks( self ) :
+
+		network = IECoreScene.ShaderNetwork(
+			shaders = {
+				"image" : IECoreScene.Shader( "aiImage", "shader", {} ),
+				"output" : IECoreScene.Shader( "Surface/Constant", "osl:surface", {} ),
+			},
+			connections = [
+				( ( "image", "" ), ( "output", "p1" ) ),
+			],
+			output = "output"
+		)
+
+		for i in range( 0, 2 ) :
+			with self.assertRaisesRegex( Exception, "The following shaders can't be used as they are not OSL shaders: aiImage \\(shader\\)" ) :
+				GafferOSL.ShadingEngine( network )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testConstructionPerformance( self ) :
+
+		shader = self.compileShader( pathlib.Path( __file__ ).parent / "shaders" / "constant.osl" )
+		network = IECoreScene.ShaderNetwork(
+			shaders = {
+				"constant" : IECoreScene.Shader( shader, "osl:surface", { "Cs" : imath.Color3f( 1, 0.5, 0.25 ) } ),
+			},
+			output = "constant",
+		)
+
+		GafferOSL.ShadingEngine( network )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for i in range( 0, 1000 ) :
+				GafferOSL.ShadingEngine( network )
+
 if __name__ == "__main__":
 	unittest.main()
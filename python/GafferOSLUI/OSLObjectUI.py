@@ -399,6 +399,21 @@ Gaffer.Metadata.registerNode(
 
 		},
 
+		"useBatchedShading" : {
+
+			"description" :
+			"""
+			Shades batches of points at once using SIMD instructions, when
+			supported by the OSL installation. This is typically much faster,
+			but may be turned off to compare results and performance with
+			non-batched shading. Shaders that can't be compiled for batched
+			shading automatically fall back to non-batched shading.
+			""",
+
+			"layout:section" : "Advanced",
+
+		},
+
 	}
 
 )
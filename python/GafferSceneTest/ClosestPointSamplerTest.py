@@ -39,6 +39,7 @@ import imath
 import IECore
 import IECoreScene
 
+import Gaffer
 import GafferTest
 import GafferScene
 import GafferSceneTest
@@ -238,6 +239,51 @@ class ClosestPointSamplerTest( GafferSceneTest.SceneTestCase ) :
 		sampler["adjustBounds"].setValue( False )
 		self.assertEqual( sampler["out"].boundHash( "/plane" ), sampler["in"].boundHash( "/plane" ) )
 
+	def testSourceEvaluatorSharedBetweenLocations( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["type"].setValue( GafferScene.Sphere.Type.Mesh )
+
+		plane = GafferScene.Plane()
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( plane["out"] )
+		duplicate["filter"].setInput( planeFilter["out"] )
+		duplicate["copies"].setValue( 50 )
+
+		allFilter = GafferScene.PathFilter()
+		allFilter["paths"].setValue( IECore.StringVectorData( [ "/plane*" ] ) )
+
+		sampler = GafferScene.ClosestPointSampler()
+		sampler["in"].setInput( duplicate["out"] )
+		sampler["source"].setInput( sphere["out"] )
+		sampler["filter"].setInput( allFilter["out"] )
+		sampler["sourceLocation"].setValue( "/sphere" )
+		sampler["primitiveVariables"].setValue( "P" )
+		sampler["prefix"].setValue( "sampled:" )
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			GafferSceneTest.traverseScene( sampler["out"] )
+
+		# The source should only have been triangulated and
+		# prepared for sampling once, rather than once per plane.
+		self.assertEqual( monitor.plugStatistics( sampler["__sourceEvaluator"] ).computeCount, 1 )
+
+		for i in range( 0, 51 ) :
+			name = "/plane{}".format( i or "" )
+			self.assertIn( "sampled:P", sampler["out"].object( name ) )
+
+		# And the result should be updated when the source changes.
+
+		sphere["radius"].setValue( 2 )
+		self.assertAlmostEqual(
+			sampler["out"].object( "/plane" )["sampled:P"].data[0].length(),
+			2, delta = 0.05
+		)
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testPerformance( self ) :
 
@@ -420,6 +420,74 @@ class CryptomatteTest( GafferSceneTest.SceneTestCase ) :
 		self.assertIn( "A2", c["out"]["channelNames"].getValue() )
 		self.assertNotIn( "A", c["out"]["channelNames"].getValue() )
 
+	def testIndexedMatchesEquivalentToWildcardMatches( self ) :
+
+		names = [ "/a{}/b{}".format( i % 10, i ) for i in range( 0, 20000 ) ]
+		names += [ "/a1!x", "/a10", "a1//noLeadingSlash", "/a1/" ]
+		manifest = { n : "{:08x}".format( i ) for i, n in enumerate( names ) }
+
+		metadata = GafferImage.ImageMetadata()
+		metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/conversion", "uint32_to_float32" ) )
+		metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/hash", "MurmurHash3_32" ) )
+		metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/name", "crypto_object" ) )
+		metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/manifest", json.dumps( manifest ) ) )
+
+		c = GafferScene.Cryptomatte()
+		c["in"].setInput( metadata["out"] )
+		c["layer"].setValue( "crypto_object" )
+
+		# Without a manifest, only the hash of the name itself is matched.
+		noManifest = GafferScene.Cryptomatte()
+
+		def nameValues( name ) :
+
+			noManifest["matteNames"].setValue( IECore.StringVectorData( [ name ] ) )
+			return set( noManifest["__matteValues"].getValue() )
+
+		for name, wildcardName in [
+			( "/a1", "/a[1]" ),
+			( "/a1/b1", "/a1/b[1]" ),
+			( "a1", "/a[1]" ),
+		] :
+
+			# Names without wildcards are matched using the manifest index.
+			c["matteNames"].setValue( IECore.StringVectorData( [ name ] ) )
+			indexed = set( c["__matteValues"].getValue() )
+
+			# Wildcards require a search of the whole manifest.
+			c["matteNames"].setValue( IECore.StringVectorData( [ wildcardName ] ) )
+			searched = set( c["__matteValues"].getValue() )
+
+			self.assertEqual( indexed - nameValues( name ), searched - nameValues( wildcardName ) )
+
+		# 2000 "/a1/b*" entries, "a1//noLeadingSlash", "/a1/", and "/a1" itself.
+		c["matteNames"].setValue( IECore.StringVectorData( [ "/a1" ] ) )
+		self.assertEqual( len( c["__matteValues"].getValue() ), 2003 )
+
+	def testManifestSharedBetweenImages( self ) :
+
+		manifest = json.dumps( { "/cow" : "f0411c1b", "/cow1" : "9fa8a4a0" } )
+
+		c = []
+		for i in range( 0, 2 ) :
+
+			metadata = GafferImage.ImageMetadata()
+			metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/conversion", "uint32_to_float32" ) )
+			metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/hash", "MurmurHash3_32" ) )
+			metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/name", "crypto_object" ) )
+			metadata["metadata"].addChild( Gaffer.NameValuePlug( "cryptomatte/f834d0a/manifest", manifest ) )
+			# Differs between images, as a frame-dependent entry would.
+			metadata["metadata"].addChild( Gaffer.NameValuePlug( "frame", i ) )
+
+			cryptomatte = GafferScene.Cryptomatte()
+			cryptomatte["in"].setInput( metadata["out"] )
+			cryptomatte["layer"].setValue( "crypto_object" )
+			c.append( ( metadata, cryptomatte ) )
+
+		self.assertNotEqual( c[0][1]["__manifest"].hash(), c[1][1]["__manifest"].hash() )
+		self.assertTrue( c[0][1]["__manifest"].getValue( _copy = False ).isSame( c[1][1]["__manifest"].getValue( _copy = False ) ) )
+		self.assertEqual( c[0][1]["__manifest"].getValue()["4030791963"], IECore.StringData( "/cow" ) )
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testPerformance( self ) :
 
@@ -83,6 +83,27 @@ class DuplicateTest( GafferSceneTest.SceneTestCase ) :
 			self.assertPathHashesEqual( d["out"], "/sphere", d["out"], path, checks = self.allPathChecks - { "transform" } )
 			self.assertEqual( d["out"].transform( path ), imath.M44f().translate( imath.V3f( 1, 0, 0 ) * i ) )
 
+	def testManyCopiesTransforms( self ) :
+
+		s = GafferScene.Sphere()
+		d = GafferScene.Duplicate()
+		d["in"].setInput( s["out"] )
+		d["target"].setValue( "/sphere" )
+		d["transform"]["translate"].setValue( imath.V3f( 1, 0.5, 0 ) )
+		d["transform"]["rotate"].setValue( imath.V3f( 0, 1, 3 ) )
+		d["transform"]["scale"].setValue( imath.V3f( 1.001 ) )
+		d["copies"].setValue( 1000 )
+
+		matrix = d["transform"].matrix()
+		expected = []
+		m = matrix
+		for i in range( 0, 1000 ) :
+			expected.append( m )
+			m = m * matrix
+
+		for i in [ 0, 1, 6, 7, 8, 9, 15, 16, 62, 63, 64, 65, 127, 128, 500, 999 ] :
+			self.assertEqual( d["out"].transform( "/sphere{}".format( i + 1 ) ), expected[i] )
+
 	def testHierarchy( self ) :
 
 		s = GafferScene.Sphere()
@@ -249,6 +270,40 @@ class DuplicateTest( GafferSceneTest.SceneTestCase ) :
 		with GafferTest.TestRunner.PerformanceScope() :
 			GafferSceneTest.traverseScene( duplicate["out"] )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testBoundPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["transform"]["translate"]["x"].setValue( 2 )
+		duplicate["copies"].setValue( 100000 )
+
+		# The bound of the root must look up the transform of every copy.
+
+		duplicate["out"].childNames( "/" )
+		sphere["out"].bound( "/sphere" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			duplicate["out"].bound( "/" )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testTransformPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["transform"]["translate"]["x"].setValue( 2 )
+		duplicate["copies"].setValue( 100000 )
+
+		paths = [ "/{}".format( n ) for n in duplicate["out"].childNames( "/" ) ]
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for path in paths :
+				duplicate["out"].transform( path )
+
 	def testFilter( self ) :
 		cube = GafferScene.Cube()
 		cube["sets"].setValue( "boxes" )
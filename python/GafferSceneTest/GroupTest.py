@@ -842,6 +842,73 @@ class GroupTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( group["out"].set( "C" ).value, IECore.PathMatcher( [ "/world" ] ) )
 		self.assertEqual( group["out"].set( "D" ).value, IECore.PathMatcher() )
 
+	def testSetsWithRenamesClaimingInputNames( self ) :
+
+		# The second input contains both "a" and "a1", but "a" is renamed
+		# to "a1" to avoid the clash with the first input, so "a1" must
+		# also be renamed, to "a2".
+
+		sphereA = GafferScene.Sphere()
+		sphereA["name"].setValue( "a" )
+		sphereA["sets"].setValue( "A" )
+
+		sphereA1 = GafferScene.Sphere()
+		sphereA1["name"].setValue( "a1" )
+		sphereA1["sets"].setValue( "A" )
+
+		setA1 = GafferScene.Set()
+		setA1["in"].setInput( sphereA1["out"] )
+		setA1["name"].setValue( "B" )
+		setA1["paths"].setValue( IECore.StringVectorData( [ "/a1", "/notAChild" ] ) )
+
+		merge = GafferScene.Parent()
+		merge["parent"].setValue( "/" )
+		merge["in"].setInput( sphereA["out"] )
+		merge["children"][0].setInput( setA1["out"] )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphereA["out"] )
+		group["in"][1].setInput( merge["out"] )
+
+		self.assertEqual( group["out"].childNames( "/group" ), IECore.InternedStringVectorData( [ "a", "a1", "a2" ] ) )
+		self.assertEqual( group["out"].set( "A" ).value, IECore.PathMatcher( [ "/group/a", "/group/a1", "/group/a2" ] ) )
+		self.assertEqual( group["out"].set( "B" ).value, IECore.PathMatcher( [ "/group/a2" ] ) )
+		self.assertSceneValid( group["out"] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testWideGroupPerformance( self ) :
+
+		# 200 inputs, each with 500 children, a tenth of which
+		# clash with children from the other inputs.
+
+		sources = []
+		for i in range( 0, 200 ) :
+			source = GafferSceneTest.CompoundObjectSource()
+			source["in"].setValue(
+				IECore.CompoundObject( {
+					"bound" : IECore.Box3fData( imath.Box3f( imath.V3f( -1 ), imath.V3f( 1 ) ) ),
+					"children" : {
+						( "shared{}x".format( c ) if c % 10 == 0 else "input{}_{}".format( i, c ) ) : {
+							"bound" : IECore.Box3fData( imath.Box3f( imath.V3f( -1 ), imath.V3f( 1 ) ) ),
+						}
+						for c in range( 0, 500 )
+					},
+				} ),
+			)
+			source["out"].childNames( "/" )
+			sources.append( source )
+
+		group = GafferScene.Group()
+		for i, source in enumerate( sources ) :
+			group["in"][i].setInput( source["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			childNames = group["out"].childNames( "/group" )
+			for i in range( 0, len( childNames ), 100 ) :
+				group["out"].bound( "/group/" + str( childNames[i] ) )
+
+		self.assertEqual( len( childNames ), 100000 )
+
 	def setUp( self ) :
 
 		GafferSceneTest.SceneTestCase.setUp( self )
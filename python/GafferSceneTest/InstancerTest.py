@@ -727,6 +727,117 @@ class InstancerTest( GafferSceneTest.SceneTestCase ) :
 		)
 		self.assertEncapsulatedRendersSame( instancer )
 
+	def testBoundMatchesTransforms( self ) :
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, x % 3, -x ) for x in range( 1000 ) ] ) )
+		points["orientation"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.QuatfVectorData( [ ( 1 + x % 2 ) * imath.Quatf().setAxisAngle( imath.V3f( 1, x, 2 ).normalized(), x * 0.1 ) for x in range( 1000 ) ] )
+		)
+		points["scale"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ imath.V3f( 1 + x % 5, 2, 0.5 + x % 7 ) for x in range( 1000 ) ] )
+		)
+		points["uniformScale"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.FloatVectorData( [ 1 + x % 4 for x in range( 1000 ) ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		cube = GafferScene.Cube()
+		cube["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["prototypes"].setInput( cube["out"] )
+		instancer["parent"].setValue( "/object" )
+
+		for orientation, scale in [
+			( "", "" ),
+			( "orientation", "" ),
+			( "", "scale" ),
+			( "orientation", "scale" ),
+			( "orientation", "uniformScale" ),
+		] :
+
+			instancer["orientation"].setValue( orientation )
+			instancer["scale"].setValue( scale )
+
+			expectedBound = imath.Box3f()
+			for i in range( 0, 1000 ) :
+
+				transform = instancer["out"].transform( "/object/instances/cube/{}".format( i ) )
+
+				# Instancer transforms are S * R * T. `M44f.scale()` premultiplies,
+				# so we apply it after setting the rotation.
+				expectedTransform = imath.M44f()
+				if orientation :
+					expectedTransform = points["orientation"].data[i].normalized().toMatrix44()
+				if scale == "scale" :
+					expectedTransform.scale( points["scale"].data[i] )
+				elif scale == "uniformScale" :
+					expectedTransform.scale( imath.V3f( points["uniformScale"].data[i] ) )
+				if orientation :
+					self.assertTrue( transform.equalWithAbsError( expectedTransform * imath.M44f().translate( points["P"].data[i] ), 0.00001 ) )
+				else :
+					self.assertEqual( transform, expectedTransform * imath.M44f().translate( points["P"].data[i] ) )
+
+				cubeBound = cube["out"].bound( "/cube" )
+				for x in ( cubeBound.min().x, cubeBound.max().x ) :
+					for y in ( cubeBound.min().y, cubeBound.max().y ) :
+						for z in ( cubeBound.min().z, cubeBound.max().z ) :
+							expectedBound.extendBy( imath.V3f( x, y, z ) * cube["out"].transform( "/cube" ) * transform )
+
+			bound = instancer["out"].bound( "/object/instances/cube" )
+			self.assertTrue( bound.min().equalWithAbsError( expectedBound.min(), 0.01 ) )
+			self.assertTrue( bound.max().equalWithAbsError( expectedBound.max(), 0.01 ) )
+
+	def testEncapsulatedRenderWithManyInstances( self ) :
+
+		# Enough instances to span several of the chunks used when
+		# expanding the capsule, with some points omitted so that the
+		# chunks aren't all full.
+
+		numPoints = 3000
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( numPoints ) ] ) )
+		points["orientation"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.QuatfVectorData( [ imath.Quatf().setAxisAngle( imath.V3f( 0, 1, 0 ), x * 0.01 ) for x in range( numPoints ) ] )
+		)
+		points["prototypeIndex"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ x % 3 for x in range( numPoints ) ] )
+		)
+		points["inactive"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.BoolVectorData( [ x % 7 == 0 for x in range( numPoints ) ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		sphere = GafferScene.Sphere()
+		cube = GafferScene.Cube()
+
+		prototypes = GafferScene.Parent()
+		prototypes["parent"].setValue( "/" )
+		prototypes["in"].setInput( sphere["out"] )
+		prototypes["children"][0].setInput( cube["out"] )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["prototypes"].setInput( prototypes["out"] )
+		instancer["parent"].setValue( "/object" )
+		instancer["prototypeMode"].setValue( GafferScene.Instancer.PrototypeMode.IndexedRootsList )
+		instancer["prototypeIndex"].setValue( "prototypeIndex" )
+		instancer["prototypeRootsList"].setValue( IECore.StringVectorData( [ "/sphere", "", "/cube" ] ) )
+		instancer["orientation"].setValue( "orientation" )
+		instancer["inactiveIds"].setValue( "inactive" )
+
+		self.assertEncapsulatedRendersSame( instancer )
+
 	def testInactiveIds( self ) :
 
 		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 0, 10 ) ] ) )
@@ -1792,6 +1903,110 @@ parent["radius"] = ( 2 + context.getFrame() ) * 15
 		self.assertEqual( instancer["out"].transform( "/object/instances/sphere1/1" ), imath.M44f().translate( imath.V3f( 1, 0, 0 ) ) )
 		self.assertEqual( instancer["out"].transform( "/object/instances/sphere1/4" ), imath.M44f().translate( imath.V3f( 5, 0, 0 ) ) )
 
+	def testEditPointsWithSameIds( self ) :
+
+		# The Instancer shares the tables mapping ids to point indices
+		# and point indices to prototypes between engines with the same
+		# ids and prototype indices. Check that editing positions reuses
+		# them correctly, and that editing ids or prototype indices doesn't
+		# reuse stale tables.
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 6 ) ] ) )
+		points["id"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 10, 11, 12, 12, 13, 14 ] ),
+		)
+		points["prototypeIndex"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 0, 1, 0, 1, 0, 1 ] ),
+		)
+		points["inactive"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Constant,
+			IECore.IntVectorData( [ 14 ] ),
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		sphere = GafferScene.Sphere()
+		parent = GafferScene.Parent()
+		parent["parent"].setValue( "/" )
+		parent["in"].setInput( sphere["out"] )
+		parent["children"][0].setInput( sphere["out"] )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["prototypes"].setInput( parent["out"] )
+		instancer["parent"].setValue( "/object" )
+		instancer["id"].setValue( "id" )
+		instancer["omitDuplicateIds"].setValue( True )
+		instancer["prototypeIndex"].setValue( "prototypeIndex" )
+		instancer["inactiveIds"].setValue( "inactive" )
+
+		def assertInstances( offset, expected ) :
+
+			self.assertSceneValid( instancer["out"] )
+			for prototype, ids in expected.items() :
+				self.assertEqual(
+					instancer["out"].childNames( "/object/instances/" + prototype ),
+					IECore.InternedStringVectorData( [ str( i ) for i, index in ids ] )
+				)
+				for i, index in ids :
+					self.assertEqual(
+						instancer["out"].transform( "/object/instances/{}/{}".format( prototype, i ) ),
+						imath.M44f().translate( imath.V3f( index + offset, 0, 0 ) )
+					)
+
+		assertInstances( 0, { "sphere" : [ ( 10, 0 ), ( 13, 4 ) ], "sphere1" : [ ( 11, 1 ) ] } )
+
+		for offset in range( 1, 4 ) :
+			points["P"] = IECore.V3fVectorData( [ imath.V3f( x + offset, 0, 0 ) for x in range( 6 ) ] )
+			objectToScene["object"].setValue( points )
+			assertInstances( offset, { "sphere" : [ ( 10, 0 ), ( 13, 4 ) ], "sphere1" : [ ( 11, 1 ) ] } )
+
+		points["id"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 10, 11, 12, 15, 13, 14 ] ),
+		)
+		objectToScene["object"].setValue( points )
+		assertInstances( 3, { "sphere" : [ ( 10, 0 ), ( 12, 2 ), ( 13, 4 ) ], "sphere1" : [ ( 11, 1 ), ( 15, 3 ) ] } )
+
+		points["prototypeIndex"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 1, 1, 0, 1, 0, 1 ] ),
+		)
+		objectToScene["object"].setValue( points )
+		assertInstances( 3, { "sphere" : [ ( 12, 2 ), ( 13, 4 ) ], "sphere1" : [ ( 10, 0 ), ( 11, 1 ), ( 15, 3 ) ] } )
+
+		points["inactive"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Constant,
+			IECore.IntVectorData( [ 11 ] ),
+		)
+		objectToScene["object"].setValue( points )
+		assertInstances( 3, { "sphere" : [ ( 12, 2 ), ( 13, 4 ) ], "sphere1" : [ ( 10, 0 ), ( 14, 5 ), ( 15, 3 ) ] } )
+
+		# Back to the original ids, which should give the same result as at the start.
+
+		points["id"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 10, 11, 12, 12, 13, 14 ] ),
+		)
+		points["prototypeIndex"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 0, 1, 0, 1, 0, 1 ] ),
+		)
+		points["inactive"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Constant,
+			IECore.IntVectorData( [ 14 ] ),
+		)
+		points["P"] = IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 6 ) ] )
+		objectToScene["object"].setValue( points )
+		assertInstances( 0, { "sphere" : [ ( 10, 0 ), ( 13, 4 ) ], "sphere1" : [ ( 11, 1 ) ] } )
+
+		instancer["omitDuplicateIds"].setValue( False )
+		with self.assertRaisesRegex( RuntimeError, 'Instance id "12" is duplicated at index 2 and 3' ) :
+			instancer["out"].childNames( "/object/instances/sphere" )
+
 	def testAttributes( self ) :
 
 		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 0, 2 ) ] ) )
@@ -3314,6 +3529,36 @@ parent["radius"] = ( 2 + context.getFrame() ) * 15
 
 
 
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 10 )
+	def testBoundPerformanceWithScale( self ) :
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x ) for x in range( 1000000 ) ] ) )
+		points["orientation"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.QuatfVectorData( [ imath.Quatf().setAxisAngle( imath.V3f( 0, 1, 0 ), x ) for x in range( 1000000 ) ] )
+		)
+		points["scale"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ imath.V3f( 1, 2, 3 ) ] * 1000000 )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		cube = GafferScene.Cube()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["prototypes"].setInput( cube["out"] )
+		instancer["parent"].setValue( "/object" )
+		instancer["orientation"].setValue( "orientation" )
+		instancer["scale"].setValue( "scale" )
+
+		instancer["out"].childNames( "/object/instances/cube" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			instancer["out"].bound( "/object/instances/cube" )
+
 	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 10 )
 	def testBoundPerformance( self ) :
 
@@ -117,5 +117,42 @@ class MeshNormalsTest( GafferSceneTest.SceneTestCase ) :
 				sortedVec.equalWithRelError( imath.V3f( 1, 2, 2 ).normalized(), 1e-7 )
 			)
 
+	def testUniformMatchesMeshAlgo( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 300 ) )
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		meshNormals = GafferScene.MeshNormals()
+		meshNormals["in"].setInput( sphere["out"] )
+		meshNormals["filter"].setInput( sphereFilter["out"] )
+		meshNormals["interpolation"].setValue( IECoreScene.PrimitiveVariable.Interpolation.Uniform )
+
+		self.assertEqual(
+			meshNormals["out"].object( "/sphere" )["N"],
+			IECoreScene.MeshAlgo.calculateUniformNormals( sphere["out"].object( "/sphere" ) )
+		)
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testUniformPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 2000 ) )
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		meshNormals = GafferScene.MeshNormals()
+		meshNormals["in"].setInput( sphere["out"] )
+		meshNormals["filter"].setInput( sphereFilter["out"] )
+		meshNormals["interpolation"].setValue( IECoreScene.PrimitiveVariable.Interpolation.Uniform )
+
+		meshNormals["in"].object( "/sphere" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			meshNormals["out"].object( "/sphere" )
+
 if __name__ == "__main__":
 	unittest.main()
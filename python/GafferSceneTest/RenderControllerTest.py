@@ -274,6 +274,75 @@ class RenderControllerTest( GafferSceneTest.SceneTestCase ) :
 
 		del capturedSphere, capturedLightA, capturedLightB
 
+	def testLightLinksAfterSetEdits( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "spheres" )
+
+		attributes = GafferScene.StandardAttributes()
+		attributes["in"].setInput( sphere["out"] )
+		attributes["attributes"]["linkedLights"]["enabled"].setValue( True )
+		attributes["attributes"]["linkedLights"]["value"].setValue( "A" )
+
+		lightA = GafferSceneTest.TestLight()
+		lightA.loadShader( "simpleLight" )
+		lightA["name"].setValue( "lightA" )
+		lightA["sets"].setValue( "A" )
+
+		lightB = GafferSceneTest.TestLight()
+		lightB.loadShader( "simpleLight" )
+		lightB["name"].setValue( "lightB" )
+		lightB["sets"].setValue( "B" )
+
+		# Light which is never linked, so that the links are never
+		# optimised to "all lights".
+		lightC = GafferSceneTest.TestLight()
+		lightC.loadShader( "simpleLight" )
+		lightC["name"].setValue( "lightC" )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( attributes["out"] )
+		group["in"][1].setInput( lightA["out"] )
+		group["in"][2].setInput( lightB["out"] )
+		group["in"][3].setInput( lightC["out"] )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( group["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 10 )
+		controller.update()
+
+		capturedSphere = renderer.capturedObject( "/group/sphere" )
+		capturedLightA = renderer.capturedObject( "/group/lightA" )
+		capturedLightB = renderer.capturedObject( "/group/lightB" )
+
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 1 )
+
+		# Editing a set which doesn't affect the linked lights shouldn't
+		# cause links to be output again.
+
+		sphere["sets"].setValue( "spheres balls" )
+		controller.update()
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 1 )
+
+		# But editing a set that the linking expression depends on should.
+
+		lightB["sets"].setValue( "A B" )
+		controller.update()
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA, capturedLightB } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 2 )
+
+		# Expressions which resolve to the same lights don't require
+		# relinking either.
+
+		attributes["attributes"]["linkedLights"]["value"].setValue( "A | B" )
+		controller.update()
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA, capturedLightB } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 2 )
+
+		del capturedSphere, capturedLightA, capturedLightB
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testLightLinkPerformance( self ) :
 
@@ -1082,6 +1151,106 @@ class RenderControllerTest( GafferSceneTest.SceneTestCase ) :
 		task.wait()
 		self.assertEqual( statuses, [ Status.Running ] * 4 + [ Status.Completed ] )
 
+	def testCameraPriority( self ) :
+
+		camera = GafferScene.Camera()
+
+		# Large on screen, because it is close to the camera.
+		nearSphere = GafferScene.Sphere()
+		nearSphere["name"].setValue( "near" )
+		nearSphere["transform"]["translate"]["z"].setValue( -3 )
+
+		# Tiny on screen, because it is far away.
+		farSphere = GafferScene.Sphere()
+		farSphere["name"].setValue( "far" )
+		farSphere["radius"].setValue( 0.01 )
+		farSphere["transform"]["translate"]["z"].setValue( -100 )
+
+		# Offscreen, because it is behind the camera.
+		behindSphere = GafferScene.Sphere()
+		behindSphere["name"].setValue( "behind" )
+		behindSphere["transform"]["translate"]["z"].setValue( 10 )
+
+		# Offscreen to one side, but tall enough to span the
+		# screen vertically.
+		tallSphere = GafferScene.Sphere()
+		tallSphere["name"].setValue( "tall" )
+		tallSphere["transform"]["translate"].setValue( imath.V3f( 20, 0, -3 ) )
+		tallSphere["transform"]["scale"]["y"].setValue( 100 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( camera["out"] )
+		group["in"][1].setInput( nearSphere["out"] )
+		group["in"][2].setInput( farSphere["out"] )
+		group["in"][3].setInput( behindSphere["out"] )
+		group["in"][4].setInput( tallSphere["out"] )
+
+		options = GafferScene.StandardOptions()
+		options["in"].setInput( group["out"] )
+		options["options"]["render:camera"]["enabled"].setValue( True )
+		options["options"]["render:camera"]["value"].setValue( "/group/camera" )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( options["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 2 )
+
+		self.assertEqual( controller.getCameraPriorityThreshold(), 0 )
+		controller.setCameraPriorityThreshold( 0.1 )
+		self.assertAlmostEqual( controller.getCameraPriorityThreshold(), 0.1, places = 6 )
+
+		capturedObjects = []
+		def callback( status ) :
+
+			if status == Gaffer.BackgroundTask.Status.Running :
+				capturedObjects.append( set( renderer.capturedObjectNames() ) )
+
+		task = controller.updateInBackground( callback )
+		task.wait()
+
+		# The near sphere should have been output before either of the others.
+
+		firstNear = next( c for c in capturedObjects if "/group/near" in c )
+		self.assertNotIn( "/group/far", firstNear )
+		self.assertNotIn( "/group/behind", firstNear )
+		self.assertNotIn( "/group/tall", firstNear )
+
+		# But everything should be output in the end.
+
+		for name in [ "/group/near", "/group/far", "/group/behind", "/group/tall" ] :
+			self.assertIsNotNone( renderer.capturedObject( name ) )
+
+	def testCameraPriorityRespectsVisibleSet( self ) :
+
+		camera = GafferScene.Camera()
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"]["z"].setValue( -3 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( camera["out"] )
+		group["in"][1].setInput( sphere["out"] )
+
+		options = GafferScene.StandardOptions()
+		options["in"].setInput( group["out"] )
+		options["options"]["render:camera"]["enabled"].setValue( True )
+		options["options"]["render:camera"]["value"].setValue( "/group/camera" )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( options["out"], Gaffer.Context(), renderer )
+		controller.setCameraPriorityThreshold( 0.1 )
+
+		# Nothing is expanded, so the sphere mustn't be output, even though it
+		# is large on screen.
+
+		task = controller.updateInBackground()
+		task.wait()
+		self.assertIsNone( renderer.capturedObject( "/group/sphere" ) )
+
+		controller.setMinimumExpansionDepth( 2 )
+		task = controller.updateInBackground()
+		task.wait()
+		self.assertIsNotNone( renderer.capturedObject( "/group/sphere" ) )
+
 	def testLightMute( self ) :
 
 		#   Light					light:mute	Muted Result
@@ -949,6 +949,102 @@ class RendererAlgoTest( GafferSceneTest.SceneTestCase ) :
 					else :
 						self.assertIsNone( capsuleRenderer.capturedObject( f"/{purpose}/cube" ) )
 
+	def testOutputObjectsInBatches( self ) :
+
+		# Output enough objects to fill several batches for
+		# `Renderer::objects()`, and check that nothing is lost.
+
+		sphere = GafferScene.Sphere()
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["filter"].setInput( sphereFilter["out"] )
+		duplicate["copies"].setValue( 2500 )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 1, 0, 0 ) )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+		)
+		manifest = GafferScene.RenderManifest()
+		GafferScene.Private.RendererAlgo.outputObjects(
+			duplicate["out"],
+			GafferScene.Private.RendererAlgo.RenderOptions( duplicate["out"] ),
+			GafferScene.Private.RendererAlgo.RenderSets( duplicate["out"] ),
+			GafferScene.Private.RendererAlgo.LightLinks( renderer ),
+			renderer, "/", manifest
+		)
+
+		names = [ "/sphere" ] + [ "/sphere{}".format( i ) for i in range( 1, 2501 ) ]
+		self.assertEqual( set( renderer.capturedObjectNames() ), set( names ) )
+
+		for name in names :
+			capturedObject = renderer.capturedObject( name )
+			self.assertEqual( capturedObject.capturedTransforms(), [ duplicate["out"].fullTransform( name ) ] )
+			self.assertEqual( capturedObject.id(), manifest.idForPath( name ) )
+			self.assertNotEqual( capturedObject.id(), 0 )
+			self.assertEqual( capturedObject.numLinkEdits( "lights" ), 1 )
+
+	def testDuplicateLocationsShareAttributes( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( sphere["out"] )
+		attributes["filter"].setInput( sphereFilter["out"] )
+		attributes["attributes"].addChild( Gaffer.NameValuePlug( "user:test", 10 ) )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( attributes["out"] )
+		duplicate["filter"].setInput( sphereFilter["out"] )
+		duplicate["copies"].setValue( 10 )
+
+		# Give one copy different attributes, so we can check
+		# that it doesn't get shared.
+
+		copyFilter = GafferScene.PathFilter()
+		copyFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere5" ] ) )
+
+		copyAttributes = GafferScene.CustomAttributes()
+		copyAttributes["in"].setInput( duplicate["out"] )
+		copyAttributes["filter"].setInput( copyFilter["out"] )
+		copyAttributes["attributes"].addChild( Gaffer.NameValuePlug( "user:test", 20 ) )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+		)
+		GafferScene.Private.RendererAlgo.outputObjects(
+			copyAttributes["out"],
+			GafferScene.Private.RendererAlgo.RenderOptions( copyAttributes["out"] ),
+			GafferScene.Private.RendererAlgo.RenderSets( copyAttributes["out"] ),
+			GafferScene.Private.RendererAlgo.LightLinks( renderer ),
+			renderer
+		)
+
+		names = [ "/sphere" ] + [ "/sphere{}".format( i ) for i in range( 1, 11 ) ]
+		self.assertEqual( set( renderer.capturedObjectNames() ), set( names ) )
+
+		for name in names :
+			capturedObject = renderer.capturedObject( name )
+			self.assertEqual( capturedObject.capturedSamples(), [ copyAttributes["out"].object( name ) ] )
+			self.assertEqual(
+				capturedObject.capturedAttributes().attributes()["user:test"],
+				IECore.IntData( 20 if name == "/sphere5" else 10 )
+			)
+			if name not in ( "/sphere", "/sphere5" ) :
+				self.assertTrue(
+					capturedObject.capturedAttributes().isSame( renderer.capturedObject( "/sphere" ).capturedAttributes() )
+				)
+
+		self.assertFalse(
+			renderer.capturedObject( "/sphere5" ).capturedAttributes().isSame( renderer.capturedObject( "/sphere" ).capturedAttributes() )
+		)
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testManifestPerformance( self ) :
 
@@ -993,5 +1089,38 @@ class RendererAlgoTest( GafferSceneTest.SceneTestCase ) :
 		with GafferTest.TestRunner.PerformanceScope():
 			GafferScene.Private.RendererAlgo.outputObjects( duplicate3["out"], renderOptions, renderSets, GafferScene.Private.RendererAlgo.LightLinks( renderer ), renderer, "/", GafferScene.RenderManifest() )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testUniqueAttributesPerformance( self ) :
+
+		# Every location has its own unique attributes, so nothing can be
+		# deduplicated, and we are measuring the overhead of identifying
+		# attribute blocks.
+
+		sphere = GafferScene.Sphere()
+
+		rootFilter = GafferScene.PathFilter()
+		rootFilter["paths"].setValue( IECore.StringVectorData( [ "/*" ] ) )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["filter"].setInput( rootFilter["out"] )
+		duplicate["copies"].setValue( 50000 )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( duplicate["out"] )
+		attributes["filter"].setInput( rootFilter["out"] )
+		for i in range( 0, 20 ) :
+			attributes["attributes"].addChild( Gaffer.NameValuePlug( "user:test{}".format( i ), "${scene:path}" ) )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+		)
+		renderOptions = GafferScene.Private.RendererAlgo.RenderOptions( attributes["out"] )
+		renderSets = GafferScene.Private.RendererAlgo.RenderSets( attributes["out"] )
+
+		GafferSceneTest.traverseScene( attributes["out"] )
+		with GafferTest.TestRunner.PerformanceScope():
+			GafferScene.Private.RendererAlgo.outputObjects( attributes["out"], renderOptions, renderSets, GafferScene.Private.RendererAlgo.LightLinks( renderer ), renderer )
+
 if __name__ == "__main__":
 	unittest.main()
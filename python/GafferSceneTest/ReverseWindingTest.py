@@ -36,9 +36,12 @@
 
 import unittest
 
+import imath
+
 import IECore
 import IECoreScene
 
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -68,5 +71,95 @@ class ReverseWindingTest( GafferSceneTest.SceneTestCase ) :
 		m1 = reverseWinding["out"].object( "/plane" )
 		self.assertEqual( m0, m1 )
 
+	def testLargeMesh( self ) :
+
+		# Enough faces to be split across several parallel tasks.
+
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 300 ) )
+
+		m0 = sphere["out"].object( "/sphere" ).copy()
+		m0["faceVaryingInt"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.FaceVarying,
+			IECore.IntVectorData( range( 0, m0.variableSize( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) ) )
+		)
+		m0.setCorners( IECore.IntVectorData( [ 0, 1 ] ), IECore.FloatVectorData( [ 2, 3 ] ) )
+		m0.setCreases( IECore.IntVectorData( [ 2 ] ), IECore.IntVectorData( [ 1, 2 ] ), IECore.FloatVectorData( [ 4 ] ) )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["name"].setValue( "sphere" )
+		objectToScene["object"].setValue( m0 )
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		reverseWinding = GafferScene.ReverseWinding()
+		reverseWinding["in"].setInput( objectToScene["out"] )
+		reverseWinding["filter"].setInput( sphereFilter["out"] )
+
+		m1 = reverseWinding["out"].object( "/sphere" )
+
+		IECoreScene.MeshAlgo.reverseWinding( m0 )
+		self.assertCornersAndCreasesEqual( m1, m0 )
+		self.assertEqual( m1.vertexIds, m0.vertexIds )
+		for name in m0.keys() :
+			self.assertEqual( m1[name], m0[name], name )
+		self.assertEqual( m1, m0 )
+
+	def testCornersAndCreases( self ) :
+
+		m0 = IECoreScene.MeshPrimitive.createPlane(
+			imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), divisions = imath.V2i( 4 )
+		)
+		m0.setCorners( IECore.IntVectorData( [ 0, 4, 24 ] ), IECore.FloatVectorData( [ 1, 2, 3 ] ) )
+		m0.setCreases(
+			IECore.IntVectorData( [ 3, 2 ] ),
+			IECore.IntVectorData( [ 5, 6, 7, 12, 17 ] ),
+			IECore.FloatVectorData( [ 4, 5 ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["name"].setValue( "plane" )
+		objectToScene["object"].setValue( m0 )
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		reverseWinding = GafferScene.ReverseWinding()
+		reverseWinding["in"].setInput( objectToScene["out"] )
+		reverseWinding["filter"].setInput( planeFilter["out"] )
+
+		m1 = reverseWinding["out"].object( "/plane" )
+
+		IECoreScene.MeshAlgo.reverseWinding( m0 )
+		self.assertCornersAndCreasesEqual( m1, m0 )
+		self.assertEqual( m1, m0 )
+
+	def assertCornersAndCreasesEqual( self, m1, m0 ) :
+
+		self.assertEqual( m1.cornerIds(), m0.cornerIds() )
+		self.assertEqual( m1.cornerSharpnesses(), m0.cornerSharpnesses() )
+		self.assertEqual( m1.creaseLengths(), m0.creaseLengths() )
+		self.assertEqual( m1.creaseIds(), m0.creaseIds() )
+		self.assertEqual( m1.creaseSharpnesses(), m0.creaseSharpnesses() )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 2000 ) )
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		reverseWinding = GafferScene.ReverseWinding()
+		reverseWinding["in"].setInput( sphere["out"] )
+		reverseWinding["filter"].setInput( sphereFilter["out"] )
+
+		reverseWinding["in"].object( "/sphere" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			reverseWinding["out"].object( "/sphere" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -43,6 +43,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -310,6 +311,116 @@ class ScatterTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( scatter["out"].object( "/plane/scatter" ).keys(), ["N", "P", "type"] )
 
+	def testLargeMesh( self ) :
+
+		# Large enough to be scattered in several parallel chunks, with
+		# Uniform and FaceVarying primitive variables that must be split
+		# between them.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 200 ) )
+
+		mesh = plane["out"].object( "/plane" ).copy()
+		mesh["d"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECore.FloatVectorData( [ ( i % 7 ) / 6.0 for i in range( 0, mesh.numFaces() ) ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["name"].setValue( "plane" )
+		objectToScene["object"].setValue( mesh )
+
+		scatter = GafferScene.Scatter()
+		scatter["in"].setInput( objectToScene["out"] )
+		scatter["parent"].setValue( "/plane" )
+		scatter["name"].setValue( "scatter" )
+		scatter["density"].setValue( 10000 )
+		scatter["densityPrimitiveVariable"].setValue( "d" )
+		scatter["primitiveVariables"].setValue( "*" )
+
+		points = scatter["out"].object( "/plane/scatter" )
+		self.assertEqual( points["type"].data, IECore.StringData( "gl:point" ) )
+		del points["type"]
+
+		expected = IECoreScene.MeshAlgo.distributePoints( mesh, 10000, imath.V2f( 0 ), "d", "uv", "P", "*" )
+		self.assertEqual( points, expected )
+
+		# Results are deterministic.
+
+		Gaffer.ValuePlug.clearCache()
+		points2 = scatter["out"].object( "/plane/scatter" )
+		del points2["type"]
+		self.assertEqual( points2, expected )
+
+	def testLargeMeshConstantAndIndexedPrimitiveVariables( self ) :
+
+		# Constant and indexed primitive variables must come out of the
+		# parallel chunks exactly as they would from a single serial scatter.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 200 ) )
+
+		mesh = plane["out"].object( "/plane" ).copy()
+		mesh["constantString"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Constant,
+			IECore.StringData( "test" )
+		)
+		mesh["constantColor"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Constant,
+			IECore.Color3fData( imath.Color3f( 1, 0.5, 0.25 ) )
+		)
+		mesh["indexedUniform"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECore.Color3fVectorData( [ imath.Color3f( i ) for i in range( 0, 5 ) ] ),
+			IECore.IntVectorData( [ i % 5 for i in range( 0, mesh.numFaces() ) ] )
+		)
+		mesh["indexedVertex"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [ 10, 20, 30 ] ),
+			IECore.IntVectorData( [ i % 3 for i in range( 0, mesh["P"].data.size() ) ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["name"].setValue( "plane" )
+		objectToScene["object"].setValue( mesh )
+
+		scatter = GafferScene.Scatter()
+		scatter["in"].setInput( objectToScene["out"] )
+		scatter["parent"].setValue( "/plane" )
+		scatter["name"].setValue( "scatter" )
+		scatter["density"].setValue( 1000 )
+		scatter["primitiveVariables"].setValue( "*" )
+
+		points = scatter["out"].object( "/plane/scatter" )
+		del points["type"]
+
+		expected = IECoreScene.MeshAlgo.distributePoints( mesh, 1000, imath.V2f( 0 ), "", "uv", "P", "*" )
+		self.assertEqual( points.keys(), expected.keys() )
+		for name in expected.keys() :
+			with self.subTest( name = name ) :
+				self.assertEqual( points[name].interpolation, expected[name].interpolation )
+				self.assertEqual( points[name].data, expected[name].data )
+				self.assertEqual( points[name].indices, expected[name].indices )
+
+		self.assertEqual( points, expected )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 1000 ) )
+
+		scatter = GafferScene.Scatter()
+		scatter["in"].setInput( plane["out"] )
+		scatter["parent"].setValue( "/plane" )
+		scatter["name"].setValue( "scatter" )
+		scatter["density"].setValue( 5000000 )
+
+		scatter["in"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			scatter["out"].object( "/plane/scatter" )
+
 	def testInternalConnectionsNotSerialised( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -464,6 +464,55 @@ class SceneReaderTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( s["out"].set( "ObjectType:SpherePrimitive" ).value.paths(), [ "/sphereGroup/sphere" ] )
 		self.assertEqual( s["out"].set( "ObjectType:MeshPrimitive" ).value.paths(), [ "/planeGroup/plane" ] )
 
+	def testTagsAsSetsInLargeHierarchy( self ) :
+
+		filePath = self.temporaryDirectory() / "test.scc"
+
+		def writeFile( tag ) :
+
+			expected = IECore.PathMatcher()
+			s = IECoreScene.SceneCache( str( filePath ), IECore.IndexedIO.OpenMode.Write )
+			for i in range( 0, 20 ) :
+				c = s.createChild( "group{}".format( i ) )
+				if i % 5 == 0 :
+					c.writeTags( [ tag ] )
+					expected.addPath( "/group{}".format( i ) )
+				for j in range( 0, 20 ) :
+					cc = c.createChild( "child{}".format( j ) )
+					if ( i + j ) % 3 == 0 :
+						cc.writeTags( [ tag ] )
+						expected.addPath( "/group{}/child{}".format( i, j ) )
+			return expected
+
+		expected = writeFile( "a" )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( filePath )
+		reader["refreshCount"].setValue( self.uniqueInt( filePath ) )
+
+		self.assertEqual( reader["out"].set( "a" ).value, expected )
+
+		# Sets should be updated when the file changes and
+		# `refreshCount` is incremented.
+
+		expected = writeFile( "b" )
+		reader["refreshCount"].setValue( self.uniqueInt( filePath ) )
+
+		self.assertEqual( reader["out"].set( "a" ).value, IECore.PathMatcher() )
+		self.assertEqual( reader["out"].set( "b" ).value, expected )
+
+		# Sets should be shared with other SceneReaders reading the same file,
+		# even though they have a different `refreshCount` and therefore a
+		# different hash.
+
+		reader2 = GafferScene.SceneReader()
+		reader2["fileName"].setValue( filePath )
+		self.assertNotEqual( reader2["out"].setHash( "b" ), reader["out"].setHash( "b" ) )
+
+		self.assertTrue(
+			reader2["out"].set( "b", _copy = False ).isSame( reader["out"].set( "b", _copy = False ) )
+		)
+
 	def testInvalidFiles( self ) :
 
 		reader = GafferScene.SceneReader()
@@ -42,6 +42,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferDispatch
 import GafferScene
 import GafferSceneTest
@@ -516,5 +517,61 @@ class SceneWriterTest( GafferSceneTest.SceneTestCase ) :
 		scene = IECoreScene.SceneCache( writer["fileName"].getValue(), IECore.IndexedIO.Read )
 		self.assertEqual( scene.readAttribute( "gaffer:globals", 1 ), writer["in"].globals() )
 
+	def testDeepHierarchy( self ) :
+
+		# Many nested and sibling locations, to exercise the reuse of
+		# parent locations during writing.
+
+		sphere = GafferScene.Sphere()
+		sphere["type"].setValue( GafferScene.Sphere.Type.Primitive )
+
+		scene = sphere["out"]
+		nodes = []
+		for i in range( 0, 6 ) :
+			group = GafferScene.Group()
+			group["name"].setValue( "group{}".format( i ) )
+			group["in"][0].setInput( scene )
+			group["in"][1].setInput( scene )
+			group["transform"]["translate"]["x"].setValue( i )
+			nodes.append( group )
+			scene = group["out"]
+
+		writer = GafferScene.SceneWriter()
+		writer["in"].setInput( scene )
+
+		for extension in self.__extensions :
+			with self.subTest( extension = extension ) :
+
+				writer["fileName"].setValue( self.temporaryDirectory() / ( "test" + extension ) )
+				writer["task"].execute()
+
+				reader = GafferScene.SceneReader()
+				reader["fileName"].setInput( writer["fileName"] )
+				self.assertScenesEqual( reader["out"], scene, checks = { "childNames", "transform" } )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testWritePerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["type"].setValue( GafferScene.Sphere.Type.Primitive )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 5000 )
+
+		group = GafferScene.Group()
+		for i in range( 0, 10 ) :
+			group["in"][i].setInput( duplicate["out"] )
+
+		writer = GafferScene.SceneWriter()
+		writer["in"].setInput( group["out"] )
+		writer["fileName"].setValue( self.temporaryDirectory() / "test.scc" )
+
+		GafferSceneTest.traverseScene( group["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			writer["task"].execute()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -40,6 +40,7 @@ import functools
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -331,6 +332,63 @@ class SetAlgoTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertFalse( GafferScene.SetAlgo.affectsSetExpression( Gaffer.IntPlug() ) )
 
+	def testEvaluationTracksSetChanges( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "A" )
+
+		cube = GafferScene.Cube()
+		cube["sets"].setValue( "B" )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( cube["out"] )
+
+		# Evaluate repeatedly, to make sure we don't get stale results
+		# back from any caching when the sets change.
+
+		for i in range( 0, 2 ) :
+			self.assertCorrectEvaluation( group["out"], "A | B", [ "/group/sphere", "/group/cube" ] )
+			self.assertCorrectEvaluation( group["out"], "(A | B) - A", [ "/group/cube" ] )
+			self.assertCorrectEvaluation( group["out"], "/group/cube | A", [ "/group/sphere", "/group/cube" ] )
+
+		cube["sets"].setValue( "A" )
+
+		for i in range( 0, 2 ) :
+			self.assertCorrectEvaluation( group["out"], "A | B", [ "/group/sphere", "/group/cube" ] )
+			self.assertCorrectEvaluation( group["out"], "(A | B) - A", [] )
+
+		cube["name"].setValue( "box" )
+		self.assertCorrectEvaluation( group["out"], "A | B", [ "/group/sphere", "/group/box" ] )
+
+		# Errors shouldn't be cached either.
+
+		for i in range( 0, 2 ) :
+			with self.assertRaisesRegex( RuntimeError, "Syntax error" ) :
+				GafferScene.SetAlgo.evaluateSetExpression( "A | (", group["out"] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testEvaluationPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 100000 )
+
+		setNode = GafferScene.Set()
+		setNode["in"].setInput( duplicate["out"] )
+		setNode["name"].setValue( "A" )
+		setNode["paths"].setValue( IECore.StringVectorData( [ "/sphere*" ] ) )
+
+		expression = " | ".join( "(A - /sphere{0})".format( i ) for i in range( 1, 50 ) )
+		GafferScene.SetAlgo.evaluateSetExpression( "A", setNode["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for i in range( 0, 100 ) :
+				GafferScene.SetAlgo.evaluateSetExpression( expression, setNode["out"] )
+
 	def assertCorrectEvaluation( self, scenePlug, expression, expectedContents ) :
 
 		result = set( GafferScene.SetAlgo.evaluateSetExpression( expression, scenePlug ).paths() )
@@ -378,6 +378,39 @@ class USDLayerWriterTest( GafferSceneTest.SceneTestCase ) :
 		reader["fileName"].setValue( compositionFileName )
 		self.assertEqual( reader["out"].set( "setA" ), setNode["out"].set( "setA" ) )
 
+	def testIdenticalSetsWithModifiedSet( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "setA setB" )
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( sphere["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/group/sphere" ] ) )
+
+		setNode = GafferScene.Set()
+		setNode["in"].setInput( group["out"] )
+		setNode["filter"].setInput( pathFilter["out"] )
+		setNode["name"].setValue( "setA" )
+		setNode["mode"].setValue( setNode.Mode.Remove )
+
+		self.assertEqual( setNode["out"].set( "setA" ).value, IECore.PathMatcher( [ "/group/sphere1" ] ) )
+		self.assertEqual( setNode["out"].setHash( "setB" ), group["out"].setHash( "setB" ) )
+
+		layerFileName, compositionFileName = self.__writeLayerAndComposition( group["out"], setNode["out"] )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( compositionFileName )
+		self.assertEqual( set( reader["out"].setNames() ), { "setA", "setB" } )
+		self.assertEqual( reader["out"].set( "setA" ), setNode["out"].set( "setA" ) )
+		self.assertEqual( reader["out"].set( "setB" ), setNode["out"].set( "setB" ) )
+
+		# The identical set should not have been written to the layer.
+
+		reader["fileName"].setValue( layerFileName )
+		self.assertNotIn( "setB", reader["out"].setNames() )
+
 	def testAnimatedTransform( self ) :
 
 		sphere = GafferScene.Sphere()
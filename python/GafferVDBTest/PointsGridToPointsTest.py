@@ -71,6 +71,28 @@ class PointsGridToPointsTest( GafferVDBTest.VDBTestCase ) :
 		self.assertEqual( len( points["P"].data), 8 )
 		self.assertEqual( points["P"].data[0], imath.V3f( -0.500004232, 0.366468042, 0.261457711  ) )
 
+	def testPrimitiveVariables( self ) :
+
+		sceneReader = GafferScene.SceneReader( "SceneReader" )
+		sceneReader["fileName"].setValue( self.sourcePath )
+
+		pointsFilter = GafferScene.PathFilter()
+		pointsFilter["paths"].setValue( IECore.StringVectorData( [ "/vdb" ] ) )
+
+		pointsGridToPoints = GafferVDB.PointsGridToPoints( "PointsGridToPoints" )
+		pointsGridToPoints["in"].setInput( sceneReader["out"] )
+		pointsGridToPoints["filter"].setInput( pointsFilter["out"] )
+		pointsGridToPoints["names"].setValue( "*" )
+
+		points = pointsGridToPoints["out"].object( "/vdb" )
+		self.assertTrue( points.arePrimitiveVariablesValid() )
+		for name in points.keys() :
+			self.assertEqual( points[name].interpolation, IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+			self.assertEqual( len( points[name].data ), 8 )
+
+		pointsGridToPoints["invertNames"].setValue( True )
+		self.assertEqual( pointsGridToPoints["out"].object( "/vdb" ).keys(), [ "P" ] )
+
 	def testVDBObjectLeftUnchangedIfIncorrectGrid( self ) :
 
 		sceneReader = GafferScene.SceneReader( "SceneReader" )
@@ -64,12 +64,16 @@
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/container/flat_map.hpp"
 
+#include "tbb/blocked_range.h"
 #include "tbb/concurrent_unordered_map.h"
 #include "tbb/concurrent_hash_map.h"
 #include "tbb/concurrent_vector.h"
+#include "tbb/parallel_for.h"
 
 #include "fmt/format.h"
 
+#include <atomic>
+#include <chrono>
 #include <tuple>
 #include <unordered_map>
 
@@ -220,8 +224,8 @@ namespace
 struct NodeDeleter
 {
 
-	NodeDeleter( ccl::Scene *scene )
-		:	m_scene( scene )
+	NodeDeleter( ccl::Scene *scene, SceneAlgo::LockStatistics *lockStatistics )
+		:	m_scene( scene ), m_lockStatistics( lockStatistics )
 	{
 	}
 
@@ -255,7 +259,7 @@ struct NodeDeleter
 	void doPendingDeletions()
 	{
 		std::lock_guard lock( m_mutex );
-		std::lock_guard sceneLock( m_scene->mutex );
+		SceneAlgo::TimedLock sceneLock( m_scene, m_lockStatistics );
 
 		if( m_pendingObjectDeletions.size() )
 		{
@@ -284,6 +288,7 @@ struct NodeDeleter
 		}
 
 		ccl::Scene *m_scene;
+		SceneAlgo::LockStatistics *m_lockStatistics;
 
 		std::mutex m_mutex;
 		std::set<ccl::Object *> m_pendingObjectDeletions;
@@ -466,6 +471,7 @@ class CyclesShader : public IECore::RefCounted
 			const IECoreScene::ShaderNetwork *displacementShader,
 			const IECoreScene::ShaderNetwork *volumeShader,
 			ccl::Scene *scene,
+			SceneAlgo::LockStatistics *lockStatistics,
 			const std::string &name,
 			const IECore::MurmurHash &h,
 			const bool singleSided,
@@ -493,7 +499,7 @@ class CyclesShader : public IECore::RefCounted
 				);
 			}
 
-			m_shader = SceneAlgo::createNodeWithLock<ccl::Shader>( scene );
+			m_shader = SceneAlgo::createNodeWithLock<ccl::Shader>( scene, lockStatistics );
 			if( surfaceShader )
 			{
 				string shaderName( name + surfaceShader->getOutput().shader.string() );
@@ -507,7 +513,7 @@ class CyclesShader : public IECore::RefCounted
 			m_shader->set_displacement_method( displacementMethod );
 			m_shader->set_graph( std::move( graph ) );
 
-			SceneAlgo::tagUpdateWithLock( m_shader, scene );
+			SceneAlgo::tagUpdateWithLock( m_shader, scene, lockStatistics );
 		}
 
 		~CyclesShader() override
@@ -546,8 +552,8 @@ class ShaderCache
 
 	public :
 
-		ShaderCache( ccl::Scene *scene )
-			: m_scene( scene )
+		ShaderCache( ccl::Scene *scene, SceneAlgo::LockStatistics *lockStatistics )
+			: m_scene( scene ), m_lockStatistics( lockStatistics )
 		{
 		}
 
@@ -690,7 +696,7 @@ class ShaderCache
 						}
 					}
 
-					writeAccessor->second = new CyclesShader( surfaceShader, displacementShader, volumeShader, m_scene, namePrefix, h, singleSided, displacementMethod, aovShaders );
+					writeAccessor->second = new CyclesShader( surfaceShader, displacementShader, volumeShader, m_scene, m_lockStatistics, namePrefix, h, singleSided, displacementMethod, aovShaders );
 				}
 			}
 
@@ -709,6 +715,7 @@ class ShaderCache
 	private :
 
 		ccl::Scene *m_scene;
+		SceneAlgo::LockStatistics *m_lockStatistics;
 		using Cache = tbb::concurrent_hash_map<IECore::MurmurHash, CyclesShaderPtr>;
 		Cache m_cache;
 
@@ -978,7 +985,7 @@ class CyclesAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 			}
 		}
 
-		bool applyObject( ccl::Object *object, const CyclesAttributes *previousAttributes, ccl::Scene *scene ) const
+		bool applyObject( ccl::Object *object, const CyclesAttributes *previousAttributes, ccl::Scene *scene, SceneAlgo::LockStatistics *lockStatistics ) const
 		{
 			// Re-issue a new object if displacement or subdivision has changed
 			if( previousAttributes )
@@ -1077,7 +1084,7 @@ class CyclesAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 					{
 						// We need the scene lock for `set_used_shaders()`, to protect
 						// the non-atomic increment made in `ccl::Node::reference()`.
-						std::scoped_lock sceneLock( scene->mutex );
+						SceneAlgo::TimedLock sceneLock( scene, lockStatistics );
 						light->set_used_shaders( shaders );
 					}
 
@@ -1108,7 +1115,7 @@ class CyclesAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 				{
 					// We need the scene lock because `tag_used()` will modify the
 					// scene.
-					std::scoped_lock sceneLock( scene->mutex );
+					SceneAlgo::TimedLock sceneLock( scene, lockStatistics );
 					m_shader->shader()->tag_used( scene );
 					// But we also use the lock for `set_used_shaders()`, to protect
 					// the non-atomic increment made in `ccl::Node::reference()`.
@@ -1147,7 +1154,7 @@ class CyclesAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 			// Custom attributes.
 			object->attributes = m_custom;
 
-			SceneAlgo::tagUpdateWithLock( object, scene );
+			SceneAlgo::tagUpdateWithLock( object, scene, lockStatistics );
 
 			return true;
 		}
@@ -1669,10 +1676,10 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 
 	public :
 
-		CyclesObject( ccl::Scene *scene, const SharedGeometryPtr &geometry, const std::string &name, const float frame, LightLinker *lightLinker, NodeDeleter *nodeDeleter )
-			:	m_scene( scene ),
-				m_object( SceneAlgo::createNodeWithLock<ccl::Object>( scene ), NodeDeleter::ObjectDeleter( nodeDeleter ) ),
-				m_geometry( geometry ), m_frame( frame ), m_attributes( nullptr ), m_lightLinker( lightLinker )
+		CyclesObject( ccl::Scene *scene, const SharedGeometryPtr &geometry, const std::string &name, const float frame, LightLinker *lightLinker, NodeDeleter *nodeDeleter, SceneAlgo::LockStatistics *lockStatistics )
+			:	m_scene( scene ), m_lockStatistics( lockStatistics ),
+				m_object( SceneAlgo::createNodeWithLock<ccl::Object>( scene, lockStatistics ), NodeDeleter::ObjectDeleter( nodeDeleter ) ),
+				m_geometry( geometry ), m_frame( frame ), m_attributes( nullptr ), m_lightLinker( lightLinker ), m_deferTagUpdates( false )
 		{
 			assert( m_geometry );
 			m_object->name = ccl::ustring( name.c_str() );
@@ -1684,11 +1691,25 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 				// reference count on `geometry` in a non-threadsafe way.
 				/// \todo Would the Cycles project accept a patch to make the
 				/// reference count atomic?
-				std::scoped_lock sceneLock( scene->mutex );
+				SceneAlgo::TimedLock sceneLock( scene, lockStatistics );
 				m_object->set_geometry( geometry.get() );
 			}
 		}
 
+		// Constructs around an `object` that has already been created with
+		// `geometry` assigned, as is done in bulk by `Renderer::objects()`.
+		// Tag updates are deferred until `endBatch()` is called.
+		CyclesObject( ccl::Scene *scene, ccl::Object *object, const SharedGeometryPtr &geometry, const std::string &name, const float frame, LightLinker *lightLinker, NodeDeleter *nodeDeleter, SceneAlgo::LockStatistics *lockStatistics )
+			:	m_scene( scene ), m_lockStatistics( lockStatistics ),
+				m_object( object, NodeDeleter::ObjectDeleter( nodeDeleter ) ),
+				m_geometry( geometry ), m_frame( frame ), m_attributes( nullptr ), m_lightLinker( lightLinker ), m_deferTagUpdates( true )
+		{
+			assert( m_geometry );
+			assert( m_object->get_geometry() == m_geometry.get() );
+			m_object->name = ccl::ustring( name.c_str() );
+			m_object->set_random_id( std::hash<string>()( name ) );
+		}
+
 		~CyclesObject() override
 		{
 			if( m_linkedLights )
@@ -1741,7 +1762,7 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 				m_object->set_blocker_shadow_set( lightSet );
 			}
 
-			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+			tagUpdate();
 		}
 
 		void transform( const Imath::M44f &transform ) override
@@ -1768,7 +1789,7 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 
 			m_object->set_motion( motion );
 
-			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+			tagUpdate();
 		}
 
 		void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times ) override
@@ -1788,7 +1809,7 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 					motion[i] = m_object->get_tfm();
 					m_object->set_motion( motion );
 				}
-				SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+				tagUpdate();
 				return;
 			}
 
@@ -1797,7 +1818,7 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 			if( numSamples == 1 )
 			{
 				m_object->set_tfm( SocketAlgo::setTransform( samples.front() ) );
-				SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+				tagUpdate();
 				return;
 			}
 
@@ -1889,16 +1910,16 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 				}
 			}
 
-			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+			tagUpdate();
 		}
 
 		bool attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes ) override
 		{
 			const CyclesAttributes *cyclesAttributes = static_cast<const CyclesAttributes *>( attributes );
-			if( cyclesAttributes->applyObject( m_object.get(), m_attributes.get(), m_scene ) )
+			if( cyclesAttributes->applyObject( m_object.get(), m_attributes.get(), m_scene, m_lockStatistics ) )
 			{
 				m_attributes = cyclesAttributes;
-				SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+				tagUpdate();
 				return true;
 			}
 
@@ -1915,20 +1936,40 @@ class CyclesObject : public IECoreScenePreview::Renderer::ObjectInterface
 			// Instance IDs not needed in Cycles, because encapsulated instancers aren't supported.
 		}
 
+		// Performs the tag update deferred by the batch constructor. Must
+		// be called with the scene lock held.
+		void endBatch()
+		{
+			m_deferTagUpdates = false;
+			m_object->tag_update( m_scene );
+		}
+
 	private :
 
+		void tagUpdate()
+		{
+			if( !m_deferTagUpdates )
+			{
+				SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene, m_lockStatistics );
+			}
+		}
+
 		ccl::Scene *m_scene;
+		SceneAlgo::LockStatistics *m_lockStatistics;
 		using UniqueObjectPtr = std::unique_ptr<ccl::Object, NodeDeleter::ObjectDeleter>;
 		UniqueObjectPtr m_object;
 		SharedGeometryPtr m_geometry;
 		const float m_frame;
 		ConstCyclesAttributesPtr m_attributes;
 		LightLinker *m_lightLinker;
+		bool m_deferTagUpdates;
 		IECoreScenePreview::Renderer::ConstObjectSetPtr m_linkedLights;
 		IECoreScenePreview::Renderer::ConstObjectSetPtr m_shadowedLights;
 
 };
 
+IE_CORE_DECLAREPTR( CyclesObject )
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -1943,8 +1984,10 @@ class CyclesLight : public IECoreScenePreview::Renderer::ObjectInterface
 
 	public :
 
-		CyclesLight( ccl::Scene *scene, const std::string &name, NodeDeleter *nodeDeleter )
-			:	m_scene( scene ), m_light( SceneAlgo::createNodeWithLock<ccl::Light>( scene ), NodeDeleter::GeometryDeleter( nodeDeleter ) ), m_object( SceneAlgo::createNodeWithLock<ccl::Object>( scene ), NodeDeleter::ObjectDeleter( nodeDeleter ) )
+		CyclesLight( ccl::Scene *scene, const std::string &name, NodeDeleter *nodeDeleter, SceneAlgo::LockStatistics *lockStatistics )
+			:	m_scene( scene ), m_lockStatistics( lockStatistics ),
+				m_light( SceneAlgo::createNodeWithLock<ccl::Light>( scene, lockStatistics ), NodeDeleter::GeometryDeleter( nodeDeleter ) ),
+				m_object( SceneAlgo::createNodeWithLock<ccl::Object>( scene, lockStatistics ), NodeDeleter::ObjectDeleter( nodeDeleter ) )
 		{
 			m_object->set_geometry( m_light.get() );
 			m_object->set_random_id( std::hash<string>()( name ) );
@@ -1993,7 +2036,7 @@ class CyclesLight : public IECoreScenePreview::Renderer::ObjectInterface
 			}
 
 			m_object->set_tfm( SocketAlgo::setTransform( transform ) );
-			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene, m_lockStatistics );
 		}
 
 		void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times ) override
@@ -2005,11 +2048,11 @@ class CyclesLight : public IECoreScenePreview::Renderer::ObjectInterface
 		bool attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes ) override
 		{
 			const CyclesAttributes *cyclesAttributes = static_cast<const CyclesAttributes *>( attributes );
-			if( cyclesAttributes->applyObject( m_object.get(), m_attributes.get(), m_scene ) )
+			if( cyclesAttributes->applyObject( m_object.get(), m_attributes.get(), m_scene, m_lockStatistics ) )
 			{
 				m_attributes = cyclesAttributes;
-				SceneAlgo::tagUpdateWithLock( m_light.get(), m_scene );
-				SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+				SceneAlgo::tagUpdateWithLock( m_light.get(), m_scene, m_lockStatistics );
+				SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene, m_lockStatistics );
 				return true;
 			}
 
@@ -2044,12 +2087,13 @@ class CyclesLight : public IECoreScenePreview::Renderer::ObjectInterface
 				m_object->set_shadow_set_membership( membership );
 			}
 
-			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene );
+			SceneAlgo::tagUpdateWithLock( m_object.get(), m_scene, m_lockStatistics );
 		}
 
 	private :
 
 		ccl::Scene *m_scene;
+		SceneAlgo::LockStatistics *m_lockStatistics;
 		using UniqueLightPtr = std::unique_ptr<ccl::Light, NodeDeleter::GeometryDeleter>;
 		UniqueLightPtr m_light;
 		using UniqueObjectPtr = std::unique_ptr<ccl::Object, NodeDeleter::ObjectDeleter>;
@@ -2644,7 +2688,7 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 			const IECore::MessageHandler::Scope s( m_messageHandler.get() );
 			acquireSession();
 
-			ObjectInterfacePtr result = new CyclesLight( m_scene, name, m_nodeDeleter.get() );
+			ObjectInterfacePtr result = new CyclesLight( m_scene, name, m_nodeDeleter.get(), &m_lockStatistics );
 			result->attributes( attributes );
 			return result;
 		}
@@ -2663,13 +2707,15 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 			const IECore::MessageHandler::Scope s( m_messageHandler.get() );
 			acquireSession();
 
-			SharedGeometryPtr geometry = m_geometryCache->get( object, attributes, name );
+			SharedGeometryPtr geometry = convertGeometry(
+				[&] { return m_geometryCache->get( object, attributes, name ); }
+			);
 			if( !geometry )
 			{
 				return nullptr;
 			}
 
-			ObjectInterfacePtr result = new CyclesObject( m_scene, geometry, name, frame(), &m_lightLinker, m_nodeDeleter.get() );
+			ObjectInterfacePtr result = new CyclesObject( m_scene, geometry, name, frame(), &m_lightLinker, m_nodeDeleter.get(), &m_lockStatistics );
 			result->attributes( attributes );
 			return result;
 		}
@@ -2681,17 +2727,123 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 
 			/// \todo Is it actually useful to pass `name` here? It will only be meaningful for the first
 			/// CyclesObject that references it, and will be inaccurate for any additional instances.
-			SharedGeometryPtr geometry = m_geometryCache->get( samples, times, attributes, name );
+			SharedGeometryPtr geometry = convertGeometry(
+				[&] { return m_geometryCache->get( samples, times, attributes, name ); }
+			);
 			if( !geometry )
 			{
 				return nullptr;
 			}
 
-			ObjectInterfacePtr result = new CyclesObject( m_scene, geometry, name, frame(), &m_lightLinker, m_nodeDeleter.get() );
+			ObjectInterfacePtr result = new CyclesObject( m_scene, geometry, name, frame(), &m_lightLinker, m_nodeDeleter.get(), &m_lockStatistics );
 			result->attributes( attributes );
 			return result;
 		}
 
+		void objects( const std::vector<ObjectDescription> &objects, std::vector<ObjectInterfacePtr> &result ) override
+		{
+			const IECore::MessageHandler::Scope s( m_messageHandler.get() );
+			acquireSession();
+
+			result.assign( objects.size(), nullptr );
+
+			// Convert or retrieve geometry in parallel. Geometry nodes are taken
+			// from `m_nodePool`, so that conversion doesn't need to acquire the
+			// scene lock once per node.
+
+			std::vector<SharedGeometryPtr> geometry( objects.size() );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			{
+				const GeometryConversionTimer conversionTimer( m_geometryConversionNanoseconds );
+				tbb::parallel_for(
+					tbb::blocked_range<size_t>( 0, objects.size() ),
+					[&]( const tbb::blocked_range<size_t> &range ) {
+						const IECore::MessageHandler::Scope s( m_messageHandler.get() );
+						const SceneAlgo::NodePool::Scope nodePoolScope( m_nodePool.get(), objects.size() );
+						for( size_t i = range.begin(); i != range.end(); ++i )
+						{
+							const ObjectDescription &description = objects[i];
+							if( description.samples.empty() )
+							{
+								continue;
+							}
+							else if( description.sampleTimes.empty() )
+							{
+								geometry[i] = m_geometryCache->get( description.samples[0], description.attributes, description.name );
+							}
+							else
+							{
+								geometry[i] = m_geometryCache->get( description.samples, description.sampleTimes, description.attributes, description.name );
+							}
+						}
+					},
+					taskGroupContext
+				);
+			}
+
+			// Create all the nodes with a single acquisition of the scene
+			// lock, rather than several per object.
+
+			std::vector<CyclesObjectPtr> cyclesObjects( objects.size() );
+			{
+				SceneAlgo::TimedLock sceneLock( m_scene, &m_lockStatistics );
+				for( size_t i = 0; i < objects.size(); ++i )
+				{
+					if( !geometry[i] )
+					{
+						continue;
+					}
+					ccl::Object *object = m_scene->create_node<ccl::Object>();
+					object->set_geometry( geometry[i].get() );
+					cyclesObjects[i] = new CyclesObject( m_scene, object, geometry[i], objects[i].name, frame(), &m_lightLinker, m_nodeDeleter.get(), &m_lockStatistics );
+				}
+			}
+
+			// Apply attributes, transforms and links in parallel. Tag updates
+			// are deferred until the end.
+
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, objects.size() ),
+				[&]( const tbb::blocked_range<size_t> &range ) {
+					const IECore::MessageHandler::Scope s( m_messageHandler.get() );
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						CyclesObject *object = cyclesObjects[i].get();
+						if( !object )
+						{
+							continue;
+						}
+
+						const ObjectDescription &description = objects[i];
+						object->attributes( description.attributes );
+						if( description.transformSamples.size() && description.transformTimes.empty() )
+						{
+							object->transform( description.transformSamples[0] );
+						}
+						else if( description.transformSamples.size() )
+						{
+							object->transform( description.transformSamples, description.transformTimes );
+						}
+						for( const auto &[type, linkedObjects] : description.links )
+						{
+							object->link( type, linkedObjects );
+						}
+					}
+				},
+				taskGroupContext
+			);
+
+			SceneAlgo::TimedLock sceneLock( m_scene, &m_lockStatistics );
+			for( size_t i = 0; i < objects.size(); ++i )
+			{
+				if( cyclesObjects[i] )
+				{
+					cyclesObjects[i]->endBatch();
+					result[i] = cyclesObjects[i];
+				}
+			}
+		}
+
 		void render() override
 		{
 			const IECore::MessageHandler::Scope s( m_messageHandler.get() );
@@ -2779,6 +2931,15 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 				updateOptions();
 				return sessionParamsAsData( m_session->params );
 			}
+			else if( name == "cycles:queryStatistics" )
+			{
+				CompoundDataPtr result = new CompoundData;
+				result->writable()["sceneLockAcquisitions"] = new UInt64Data( m_lockStatistics.acquisitions );
+				result->writable()["sceneLockWaitTime"] = new DoubleData( m_lockStatistics.waitNanoseconds / 1e9 );
+				result->writable()["sceneLockHoldTime"] = new DoubleData( m_lockStatistics.holdNanoseconds / 1e9 );
+				result->writable()["geometryConversionTime"] = new DoubleData( m_geometryConversionNanoseconds / 1e9 );
+				return result;
+			}
 			else if( boost::starts_with( name.string(), "cycles:" ) || name.string().find( ":" ) == string::npos )
 			{
 				IECore::msg( IECore::Msg::Warning, "CyclesRenderer::command", fmt::format( "Unknown command \"{}\"", name.c_str() ) );
@@ -2858,6 +3019,39 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 			return params;
 		}
 
+		// Adds the lifetime of the timer to `nanoseconds`.
+		struct GeometryConversionTimer
+		{
+
+			GeometryConversionTimer( std::atomic<uint64_t> &nanoseconds )
+				:	m_nanoseconds( nanoseconds ), m_start( std::chrono::steady_clock::now() )
+			{
+			}
+
+			~GeometryConversionTimer()
+			{
+				m_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - m_start
+				).count();
+			}
+
+			private :
+
+				std::atomic<uint64_t> &m_nanoseconds;
+				const std::chrono::steady_clock::time_point m_start;
+
+		};
+
+		// Used by `object()` to convert a single piece of geometry, taking
+		// its node from `m_nodePool` in the same way as `objects()` does.
+		template<typename F>
+		SharedGeometryPtr convertGeometry( F &&f )
+		{
+			const GeometryConversionTimer conversionTimer( m_geometryConversionNanoseconds );
+			const SceneAlgo::NodePool::Scope nodePoolScope( m_nodePool.get(), 1 );
+			return f();
+		}
+
 		void acquireSession()
 		{
 			// Lock is needed because `acquireSession()` can be called from multiple
@@ -2891,11 +3085,12 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 
 			if( m_renderType == RenderType::Interactive )
 			{
-				m_nodeDeleter = std::make_unique<NodeDeleter>( m_scene );
+				m_nodeDeleter = std::make_unique<NodeDeleter>( m_scene, &m_lockStatistics );
 			}
 
-			m_shaderCache = std::make_unique<ShaderCache>( m_scene );
+			m_shaderCache = std::make_unique<ShaderCache>( m_scene, &m_lockStatistics );
 			m_geometryCache = std::make_unique<GeometryCache>( m_session.get(), m_nodeDeleter.get() );
+			m_nodePool = std::make_unique<SceneAlgo::NodePool>( m_scene, &m_lockStatistics );
 			m_attributesCache = std::make_unique<AttributesCache>( m_shaderCache.get() );
 		}
 
@@ -3424,6 +3619,12 @@ class CyclesRenderer final : public IECoreScenePreview::Renderer
 		ccl::BufferParams m_bufferParams;
 		std::unique_ptr<NodeDeleter> m_nodeDeleter;
 
+		// Statistics, available via the `cycles:queryStatistics` command.
+		SceneAlgo::LockStatistics m_lockStatistics;
+		std::atomic<uint64_t> m_geometryConversionNanoseconds = 0;
+
+		std::unique_ptr<SceneAlgo::NodePool> m_nodePool;
+
 		// Background shader
 		CyclesShaderPtr m_backgroundShader;
 
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "SceneAlgo.h"
+
+#include <cassert>
+#include <set>
+
+using namespace IECoreCycles::SceneAlgo;
+
+namespace
+{
+
+thread_local const NodePool::Scope *g_currentScope = nullptr;
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// NodePool
+//////////////////////////////////////////////////////////////////////////
+
+NodePool::NodePool( ccl::Scene *scene, LockStatistics *statistics )
+	:	m_scene( scene ), m_statistics( statistics ), m_activeScopes( 0 )
+{
+}
+
+NodePool::~NodePool()
+{
+	assert( !m_activeScopes );
+}
+
+const NodePool::Scope *NodePool::currentScope()
+{
+	return g_currentScope;
+}
+
+void NodePool::beginScope()
+{
+	std::lock_guard lock( m_mutex );
+	m_activeScopes++;
+}
+
+void NodePool::endScope()
+{
+	std::lock_guard lock( m_mutex );
+	if( --m_activeScopes == 0 )
+	{
+		deleteFreeNodes();
+	}
+}
+
+void NodePool::deleteFreeNodes()
+{
+	std::set<ccl::Geometry *> toDelete;
+	for( auto &[type, nodes] : m_nodes )
+	{
+		toDelete.insert( nodes.free.begin(), nodes.free.end() );
+		nodes.free.clear();
+	}
+
+	if( toDelete.size() )
+	{
+		TimedLock sceneLock( m_scene, m_statistics );
+		m_scene->delete_nodes( toDelete );
+	}
+}
+
+NodePool::Scope::Scope( NodePool *pool, size_t maxBatchSize )
+	:	m_pool( pool ), m_maxBatchSize( maxBatchSize ), m_previous( g_currentScope )
+{
+	m_pool->beginScope();
+	g_currentScope = this;
+}
+
+NodePool::Scope::~Scope()
+{
+	g_currentScope = m_previous;
+	m_pool->endScope();
+}
@@ -34,26 +34,184 @@
 
 #pragma once
 
+#include "IECore/Export.h"
+
 IECORE_PUSH_DEFAULT_VISIBILITY
+#include "scene/geometry.h"
 #include "scene/scene.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
 namespace IECoreCycles::SceneAlgo
 {
 
-template<typename T, typename... Args> T *createNodeWithLock( ccl::Scene *scene, Args &&...args )
+using SceneMutex = decltype( ccl::Scene::mutex );
+
+/// Accumulates the time spent waiting for and holding the scene lock.
+struct LockStatistics
+{
+	std::atomic<uint64_t> acquisitions = 0;
+	std::atomic<uint64_t> waitNanoseconds = 0;
+	std::atomic<uint64_t> holdNanoseconds = 0;
+};
+
+/// Equivalent to `std::scoped_lock( scene->mutex )`, but recording timings
+/// in `statistics` if it is non-null.
+class TimedLock
+{
+
+	public :
+
+		TimedLock( ccl::Scene *scene, LockStatistics *statistics )
+			:	m_statistics( statistics ), m_start( std::chrono::steady_clock::now() ), m_lock( scene->mutex )
+		{
+			m_acquired = std::chrono::steady_clock::now();
+		}
+
+		~TimedLock()
+		{
+			if( m_statistics )
+			{
+				m_statistics->acquisitions++;
+				m_statistics->waitNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>( m_acquired - m_start ).count();
+				m_statistics->holdNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_acquired ).count();
+			}
+		}
+
+	private :
+
+		LockStatistics *m_statistics;
+		std::chrono::steady_clock::time_point m_start;
+		std::chrono::steady_clock::time_point m_acquired;
+		std::lock_guard<SceneMutex> m_lock;
+
+};
+
+/// Creates geometry nodes in batches, so that many nodes can be created with a
+/// single acquisition of the scene lock, rather than one acquisition per node.
+/// While a `NodePool::Scope` is active on the current thread,
+/// `createNodeWithLock()` takes geometry nodes from the pool. Batches grow as
+/// they are used up, but never exceed the size requested by the Scope. Nodes
+/// still unused when the last Scope for the pool ends are deleted from the
+/// scene, so that Cycles never has to process empty geometry.
+class NodePool
 {
+
+	public :
+
+		NodePool( ccl::Scene *scene, LockStatistics *statistics = nullptr );
+		~NodePool();
+
+		NodePool( const NodePool & ) = delete;
+		NodePool &operator=( const NodePool & ) = delete;
+
+		template<typename T>
+		T *acquire( size_t maxBatchSize )
+		{
+			std::lock_guard lock( m_mutex );
+			Nodes &nodes = m_nodes[T::get_node_type()];
+			if( nodes.free.empty() )
+			{
+				nodes.batchSize = std::max<size_t>( std::min<size_t>( { nodes.batchSize * 2, 1024, maxBatchSize } ), 1 );
+				TimedLock sceneLock( m_scene, m_statistics );
+				for( size_t i = 0; i < nodes.batchSize; ++i )
+				{
+					nodes.free.push_back( m_scene->create_node<T>() );
+				}
+			}
+			T *result = static_cast<T *>( nodes.free.back() );
+			nodes.free.pop_back();
+			return result;
+		}
+
+		/// Makes `pool` current for the calling thread, limiting any new
+		/// batches to `maxBatchSize` nodes. This would typically be the
+		/// number of objects being converted. Scopes may be active on
+		/// several threads at once.
+		class Scope
+		{
+
+			public :
+
+				Scope( NodePool *pool, size_t maxBatchSize );
+				~Scope();
+
+				Scope( const Scope & ) = delete;
+				Scope &operator=( const Scope & ) = delete;
+
+			private :
+
+				friend class NodePool;
+
+				NodePool *m_pool;
+				size_t m_maxBatchSize;
+				const Scope *m_previous;
+
+		};
+
+		/// Returns a node from the pool made current for `scene` by a Scope
+		/// on this thread, or null if there is no such pool.
+		template<typename T>
+		static T *acquireFromCurrent( const ccl::Scene *scene )
+		{
+			const Scope *scope = currentScope();
+			if( !scope || scope->m_pool->m_scene != scene )
+			{
+				return nullptr;
+			}
+			return scope->m_pool->acquire<T>( scope->m_maxBatchSize );
+		}
+
+	private :
+
+		static const Scope *currentScope();
+
+		void beginScope();
+		void endScope();
+		void deleteFreeNodes();
+
+		struct Nodes
+		{
+			size_t batchSize = 4;
+			std::vector<ccl::Geometry *> free;
+		};
+
+		ccl::Scene *m_scene;
+		LockStatistics *m_statistics;
+		std::mutex m_mutex;
+		std::unordered_map<const ccl::NodeType *, Nodes> m_nodes;
+		size_t m_activeScopes;
+
+};
+
+template<typename T> T *createNodeWithLock( ccl::Scene *scene, LockStatistics *statistics = nullptr )
+{
+	if constexpr( std::is_base_of_v<ccl::Geometry, T> )
+	{
+		if( T *node = NodePool::acquireFromCurrent<T>( scene ) )
+		{
+			return node;
+		}
+	}
+
 	// `Scene::create_node()` adds the new node to the relevant list
 	// (`lights`, `geometry` etc) in the Scene, so we need the lock
 	// to make that addition thread-safe.
-	std::scoped_lock lock( scene->mutex );
-	return scene->create_node<T>( std::forward<Args>( args )... );
+	TimedLock lock( scene, statistics );
+	return scene->create_node<T>();
 }
 
 template<typename T>
-void tagUpdateWithLock( T *node, ccl::Scene *scene )
+void tagUpdateWithLock( T *node, ccl::Scene *scene, LockStatistics *statistics = nullptr )
 {
-	std::scoped_lock lock( scene->mutex );
+	TimedLock lock( scene, statistics );
 	node->tag_update( scene );
 }
 
@@ -46,6 +46,7 @@
 
 #include "onnxruntime_cxx_api.h"
 
+#include <algorithm>
 #include <variant>
 
 using namespace std;
@@ -135,6 +136,16 @@ ConstTensorPtr typedImageTensor(
 			{
 				size_t dstIndex = BufferAlgo::index( V2i( p.x, dataWindow.max.y - p.y - 1 ), dataWindow ) * dstStride;
 				size_t srcIndex = BufferAlgo::index( p, tileBound );
+				if( dstStride == 1 )
+				{
+					// Rows are contiguous in both source and destination, so
+					// we can convert them in bulk.
+					std::transform(
+						sourceData + srcIndex, sourceData + srcIndex + validTileBound.size().x, dstData + dstIndex,
+						[] ( float v ) { return T{ v }; }
+					);
+					continue;
+				}
 				for( int x = validTileBound.min.x; x < validTileBound.max.x; ++x )
 				{
 					dstData[dstIndex] = T{ sourceData[srcIndex++] };
@@ -39,8 +39,11 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/Metadata.h"
 
+#include "IECore/MessageHandler.h"
 #include "IECore/SearchPath.h"
 #include "IECore/StringAlgo.h"
+#include "IECore/Timer.h"
+#include "IECore/VectorTypedData.h"
 
 #include "onnxruntime_cxx_api.h"
 #include "onnxruntime_run_options_config_keys.h"
@@ -48,8 +51,14 @@
 #include "boost/algorithm/string.hpp"
 #include "boost/algorithm/string/predicate.hpp"
 
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+
 #include <mutex>
 #include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <random>
 
 using namespace std;
 using namespace Imath;
@@ -76,9 +85,41 @@ std::vector<std::filesystem::path> customOpLibraryPaths()
 	return paths;
 }
 
+int numThreads()
+{
+	int result;
+	if( const char *c = getenv( "GAFFERML_THREADS" ) )
+	{
+		result = std::max( 0, atoi( c ) );
+	}
+	else
+	{
+		// Match the limit the user has placed on Gaffer's own TBB threads,
+		// via the `-threads` application argument.
+		result = tbb::global_control::active_value( tbb::global_control::max_allowed_parallelism );
+	}
+
+	// `Session::RunAsync()`, which we use to support cancellation, refuses to
+	// run unless the intra-op thread pool has at least 2 threads. 0 means the
+	// ONNX default of one thread per core, which we leave alone.
+	return result ? std::max( result, 2 ) : 0;
+}
+
+// By default, ONNX creates separate thread pools for every session,
+// each with a thread per core. With several models loaded, and TBB
+// threads also doing work, that leads to heavy oversubscription. So
+// instead we create a single global thread pool shared by all sessions,
+// sized to match the TBB thread limit. We also turn off spinning, so that
+// idle ONNX threads don't steal cycles from TBB.
 Ort::Env &acquireEnv()
 {
-	static Ort::Env g_env( ORT_LOGGING_LEVEL_WARNING, "Gaffer" );
+	static Ort::Env g_env = [] {
+		Ort::ThreadingOptions threadingOptions;
+		threadingOptions.SetGlobalIntraOpNumThreads( numThreads() );
+		threadingOptions.SetGlobalInterOpNumThreads( 1 );
+		threadingOptions.SetGlobalSpinControl( false );
+		return Ort::Env( threadingOptions, ORT_LOGGING_LEVEL_WARNING, "Gaffer" );
+	}();
 	return g_env;
 }
 
@@ -88,6 +129,36 @@ bool useCUDA()
 	return c && strcmp( c, "0" ) != 0;
 }
 
+std::filesystem::path optimizedModelCacheDirectory()
+{
+	const char *c = getenv( "GAFFERML_OPTIMIZED_MODEL_CACHE" );
+	return c ? c : "";
+}
+
+// Returns the path of the optimised version of `modelPath` in the cache.
+// This is keyed on the contents of the model, and on everything else that
+// affects the optimisations ONNX makes.
+std::filesystem::path optimizedModelPath( const std::filesystem::path &modelPath, const std::filesystem::path &cacheDirectory )
+{
+	IECore::MurmurHash h;
+	h.append( Ort::GetVersionString() );
+	h.append( useCUDA() );
+	for( const auto &customLibraryPath : customOpLibraryPaths() )
+	{
+		h.append( customLibraryPath.string() );
+	}
+
+	std::ifstream file( modelPath, std::ios::binary );
+	vector<char> buffer( 1024 * 1024 );
+	while( file )
+	{
+		file.read( buffer.data(), buffer.size() );
+		h.append( buffer.data(), file.gcount() );
+	}
+
+	return cacheDirectory / ( h.toString() + ".onnx" );
+}
+
 // Constructing a session (loading a model) is relatively expensive,
 // so we only ever create a single session per model. I can't find
 // a reference for this in the docs, but `Session::Run()` is thread-safe
@@ -117,6 +188,7 @@ Ort::Session &acquireSession( const std::string &fileName )
 	}
 
 	auto sessionOpt = Ort::SessionOptions();
+	sessionOpt.DisablePerSessionThreads();
 	for( const auto &customLibraryPath : customOpLibraryPaths() )
 	{
 		sessionOpt.RegisterCustomOpsLibrary( customLibraryPath.c_str() );
@@ -135,7 +207,67 @@ Ort::Session &acquireSession( const std::string &fileName )
 		}
 	}
 
-	it = g_map.try_emplace( fileName, acquireEnv(), path.c_str(), sessionOpt ).first;
+	// Graph optimisation can account for a significant proportion of the
+	// time taken to load a model, and would otherwise be repeated by every
+	// process that loads it. So if an optimised model cache has been specified,
+	// we save the optimised model there for reuse. We save models optimised
+	// at the `EXTENDED` level rather than the default `ALL` level, because the
+	// latter includes layout optimisations specific to the current hardware,
+	// making the cache unsuitable for sharing across a farm. The session we
+	// actually use is then loaded from the cache with the default options, so
+	// that the remaining optimisations are applied in every process, including
+	// the one that filled the cache. The cache is strictly best-effort :
+	// failure to write to it only produces a warning.
+
+	IECore::Timer timer;
+
+	std::filesystem::path sessionPath = path;
+	std::filesystem::path optimizedPath;
+	const std::filesystem::path cacheDirectory = optimizedModelCacheDirectory();
+	if( !cacheDirectory.empty() )
+	{
+		optimizedPath = optimizedModelPath( path, cacheDirectory );
+		if( !std::filesystem::exists( optimizedPath ) )
+		{
+			// Write to a unique temporary file and rename it into place once
+			// complete, so that concurrent processes never see partial files.
+			std::filesystem::path pendingOptimizedPath = optimizedPath;
+			pendingOptimizedPath += fmt::format( ".{}.tmp", std::random_device()() );
+			try
+			{
+				std::filesystem::create_directories( cacheDirectory );
+				Ort::SessionOptions cacheOpt = sessionOpt.Clone();
+				cacheOpt.SetGraphOptimizationLevel( GraphOptimizationLevel::ORT_ENABLE_EXTENDED );
+				cacheOpt.SetOptimizedModelFilePath( pendingOptimizedPath.c_str() );
+				Ort::Session( acquireEnv(), path.c_str(), cacheOpt );
+				std::filesystem::rename( pendingOptimizedPath, optimizedPath );
+			}
+			catch( const std::exception &e )
+			{
+				std::error_code errorCode;
+				std::filesystem::remove( pendingOptimizedPath, errorCode );
+				IECore::msg(
+					IECore::Msg::Warning, "Inference",
+					fmt::format( "Unable to write \"{}\" to optimized model cache : {}", fileName, e.what() )
+				);
+			}
+		}
+		if( std::filesystem::exists( optimizedPath ) )
+		{
+			sessionPath = optimizedPath;
+		}
+	}
+
+	it = g_map.try_emplace( fileName, acquireEnv(), sessionPath.c_str(), sessionOpt ).first;
+
+	IECore::msg(
+		IECore::Msg::Debug, "Inference",
+		fmt::format(
+			"Loaded model \"{}\" in {}s{}", fileName, timer.stop(),
+			sessionPath == optimizedPath ? " (from optimized model cache)" : ""
+		)
+	);
+
 	return it->second;
 }
 
@@ -189,6 +321,447 @@ struct AsyncWaiter
 
 };
 
+
+// Output data
+// ===========
+//
+// Where possible, we allocate output buffers ourselves as `IECore::Data`
+// and have ONNX write results directly into them, in the manner of IO
+// binding. The resulting Tensors then reference the Data, so that
+// `Tensor::asData()` can return it without copying, and so that memory
+// usage is tracked by the Data.
+
+template<typename DataType>
+IECore::DataPtr allocateData( size_t count, void *&buffer, size_t &numBytes )
+{
+	typename DataType::Ptr data = new DataType;
+	data->writable().resize( count );
+	buffer = data->baseWritable();
+	numBytes = data->baseSize() * sizeof( typename DataType::BaseType );
+	return data;
+}
+
+// Returns Data with the specified type and shape, and sets `value` to
+// reference it. Returns null if the shape isn't known, or there is no
+// suitable Data type.
+IECore::DataPtr allocateOutputData( ONNXTensorElementDataType type, const vector<int64_t> &shape, Ort::Value &value )
+{
+	size_t count = 1;
+	for( auto d : shape )
+	{
+		if( d < 0 )
+		{
+			// Dynamic dimension, only known after running.
+			return nullptr;
+		}
+		count *= d;
+	}
+
+	void *buffer = nullptr;
+	size_t numBytes = 0;
+	IECore::DataPtr data;
+	switch( type )
+	{
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT :
+			data = allocateData<FloatVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16 :
+			data = allocateData<HalfVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE :
+			data = allocateData<DoubleVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16 :
+			data = allocateData<UShortVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16 :
+			data = allocateData<ShortVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32 :
+			data = allocateData<UIntVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32 :
+			data = allocateData<IntVectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64 :
+			data = allocateData<UInt64VectorData>( count, buffer, numBytes );
+			break;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64 :
+			data = allocateData<Int64VectorData>( count, buffer, numBytes );
+			break;
+		default :
+			return nullptr;
+	}
+
+	Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu( OrtArenaAllocator, OrtMemTypeDefault );
+	value = Ort::Value::CreateTensor( memoryInfo.GetConst(), buffer, numBytes, shape.data(), shape.size(), type );
+	return data;
+}
+
+void runSession(
+	Ort::Session &session,
+	const vector<const char *> &inputNames, const vector<OrtValue *> &inputs,
+	const vector<const char *> &outputNames, vector<Ort::Value> &outputs,
+	const IECore::Canceller *canceller
+)
+{
+	// Run inference asynchronously on an ONNX thread. This allows us
+	// to check for cancellation via our AsyncWaiter.
+
+	Ort::RunOptions runOptions;
+	if( useCUDA() )
+	{
+		/// \todo Use `Env::GetEpDevices()` to get the names of all
+		/// available devices, instead of assuming a single `gpu:0` device.
+		/// We need to upgrade the ONNX version before we can do that
+		/// though.
+		runOptions.AddConfigEntry( kOrtRunOptionsConfigEnableMemoryArenaShrinkage, "gpu:0" );
+	}
+	AsyncWaiter waiter( runOptions );
+
+	session.RunAsync(
+		runOptions, inputNames.data(),
+		// The Ort C++ API wants us to pass `Ort::Value *`, but `Ort::Value`
+		// is non-copyable and the original `Ort::Value` instances are in
+		// separate TensorDatas and can't be moved. But `Ort::Value` has the
+		// same layout as `OrtValue *` (the underlying C type) so we can
+		// just reinterpret cast from the latter. Indeed, `Run()` is going
+		// to cast straight back to `OrtValue *` to call the C API!
+		reinterpret_cast<Ort::Value *>( const_cast<OrtValue **>( inputs.data() ) ),
+		inputs.size(),
+		outputNames.data(),
+		outputs.data(),
+		outputNames.size(),
+		waiter.callback,
+		&waiter
+	);
+
+	waiter.wait( canceller );
+}
+
+// Tiled inference
+// ===============
+//
+// Models operating on images typically need memory proportional to the
+// image area for their intermediate activations, so running them on large
+// images in a single `Session::Run()` can be prohibitively expensive. Tiled
+// inference splits the last two dimensions of the inputs (rows and columns)
+// into tiles, and runs each tile separately, in parallel. Each tile is padded
+// with surrounding pixels so that the model has the context it needs to
+// produce a seamless result, and only the unpadded "core" of each tile is
+// written to the output.
+
+size_t elementSize( ONNXTensorElementDataType type )
+{
+	switch( type )
+	{
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8 :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8 :
+			return 1;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16 :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16 :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16 :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16 :
+			return 2;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32 :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32 :
+			return 4;
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64 :
+		case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64 :
+			return 8;
+		default :
+			throw IECore::Exception( fmt::format( "Tiled inference does not support element type {}", (int)type ) );
+	}
+}
+
+// The range of a single dimension covered by a tile. `window` is the
+// range passed to the model, and `core` is the range written to the
+// output.
+struct TileRange
+{
+	int64_t coreBegin;
+	int64_t coreEnd;
+	int64_t windowBegin;
+	int64_t windowSize;
+};
+
+vector<TileRange> tileRanges( int64_t size, int64_t tileSize, int64_t padding )
+{
+	if( tileSize <= 0 )
+	{
+		// No tiling in this dimension.
+		return { { 0, size, 0, size } };
+	}
+
+	// All windows have the same size, so that tiling can be used with models that
+	// have fixed input dimensions. Windows at the edges are shifted inwards
+	// rather than being clipped.
+	const int64_t windowSize = std::min( tileSize + 2 * padding, size );
+
+	vector<TileRange> result;
+	for( int64_t begin = 0; begin < size; begin += tileSize )
+	{
+		result.push_back( {
+			begin, std::min( begin + tileSize, size ),
+			std::clamp<int64_t>( begin - padding, 0, size - windowSize ), windowSize
+		} );
+	}
+	return result;
+}
+
+struct Tile
+{
+	TileRange x;
+	TileRange y;
+};
+
+// Copies a `width * height` region between two tensors, treating the
+// last two dimensions as rows and columns and copying every plane of the
+// leading dimensions.
+void copyRegion(
+	const char *source, int64_t sourceWidth, int64_t sourceHeight, int64_t sourceX, int64_t sourceY,
+	char *destination, int64_t destinationWidth, int64_t destinationHeight, int64_t destinationX, int64_t destinationY,
+	int64_t width, int64_t height, int64_t numPlanes, size_t elementSize
+)
+{
+	const size_t rowBytes = width * elementSize;
+	for( int64_t plane = 0; plane < numPlanes; ++plane )
+	{
+		const char *s = source + ( ( plane * sourceHeight + sourceY ) * sourceWidth + sourceX ) * elementSize;
+		char *d = destination + ( ( plane * destinationHeight + destinationY ) * destinationWidth + destinationX ) * elementSize;
+		for( int64_t row = 0; row < height; ++row )
+		{
+			memcpy( d, s, rowBytes );
+			s += sourceWidth * elementSize;
+			d += destinationWidth * elementSize;
+		}
+	}
+}
+
+int64_t numPlanes( const vector<int64_t> &shape )
+{
+	int64_t result = 1;
+	for( size_t i = 0; i + 2 < shape.size(); ++i )
+	{
+		result *= shape[i];
+	}
+	return result;
+}
+
+vector<int64_t> modelInputShape( Ort::Session &session, const char *name )
+{
+	for( size_t i = 0; i < session.GetInputCount(); ++i )
+	{
+		Ort::AllocatedStringPtr inputName = session.GetInputNameAllocated( i, Ort::AllocatorWithDefaultOptions() );
+		if( !strcmp( inputName.get(), name ) )
+		{
+			return session.GetInputTypeInfo( i ).GetTensorTypeAndShapeInfo().GetShape();
+		}
+	}
+	return {};
+}
+
+// Returns true if `shape` appears to have interleaved channels (HWC or NHWC),
+// as produced by ImageToTensor's `interleaveChannels` mode. There is no
+// definitive way to tell, so we rely on the model declaring a fixed number
+// of channels after dynamic spatial dimensions, or failing that, on the last
+// dimension being too small to be a width while the third-from-last is too
+// large to be a channel count.
+bool interleavedChannels( const vector<int64_t> &shape, const vector<int64_t> &modelShape )
+{
+	if( shape.size() < 3 )
+	{
+		return false;
+	}
+
+	if( modelShape.size() == shape.size() && modelShape.back() > 0 && modelShape[modelShape.size()-3] <= 0 )
+	{
+		return true;
+	}
+
+	return shape.back() <= 4 && shape[shape.size()-3] > 4;
+}
+
+// Tiles over the last two dimensions of each input, so requires planar
+// (CHW or NCHW) inputs.
+void runTiledSession(
+	Ort::Session &session,
+	const vector<const char *> &inputNames, const vector<OrtValue *> &inputs,
+	const vector<const char *> &outputNames, vector<Ort::Value> &outputs, vector<IECore::DataPtr> &outputData,
+	const V2i &tileSize, int padding, const IECore::Canceller *canceller
+)
+{
+	// Find the image size from the first input with at least two
+	// dimensions. Only inputs matching this size are tiled; all others
+	// are passed to every tile unchanged.
+
+	vector<vector<int64_t>> inputShapes;
+	int64_t width = -1; int64_t height = -1;
+	for( auto input : inputs )
+	{
+		inputShapes.push_back( Ort::ConstValue( input ).GetTensorTypeAndShapeInfo().GetShape() );
+		const auto &shape = inputShapes.back();
+		if( width == -1 && shape.size() >= 2 )
+		{
+			height = shape[shape.size()-2];
+			width = shape[shape.size()-1];
+		}
+	}
+
+	if( width == -1 )
+	{
+		throw IECore::Exception( "Tiled inference requires an input with at least two dimensions" );
+	}
+
+	for( size_t i = 0; i < inputs.size(); ++i )
+	{
+		const auto &shape = inputShapes[i];
+		if(
+			shape.size() >= 2 && shape[shape.size()-2] == height && shape[shape.size()-1] == width &&
+			interleavedChannels( shape, modelInputShape( session, inputNames[i] ) )
+		)
+		{
+			throw IECore::Exception(
+				fmt::format( "Tiled inference requires planar (NCHW) inputs, but input \"{}\" appears to have interleaved channels", inputNames[i] )
+			);
+		}
+	}
+
+	if( !width || !height )
+	{
+		runSession( session, inputNames, inputs, outputNames, outputs, canceller );
+		return;
+	}
+
+	vector<Tile> tiles;
+	for( const auto &y : tileRanges( height, tileSize.y, padding ) )
+	{
+		for( const auto &x : tileRanges( width, tileSize.x, padding ) )
+		{
+			tiles.push_back( { x, y } );
+		}
+	}
+
+	// Output dimensions may be scaled relative to the input, as for
+	// upscaling models. We determine the scale from the first tile.
+
+	vector<V2i> outputScales( outputs.size(), V2i( 1 ) );
+
+	auto processTile = [&] ( const Tile &tile ) {
+
+		vector<Ort::Value> tileInputOwners;
+		vector<OrtValue *> tileInputs;
+		for( size_t i = 0; i < inputs.size(); ++i )
+		{
+			const auto &shape = inputShapes[i];
+			if( shape.size() < 2 || shape[shape.size()-2] != height || shape[shape.size()-1] != width )
+			{
+				tileInputs.push_back( inputs[i] );
+				continue;
+			}
+
+			Ort::ConstValue input( inputs[i] );
+			const ONNXTensorElementDataType type = input.GetTensorTypeAndShapeInfo().GetElementType();
+
+			vector<int64_t> tileShape = shape;
+			tileShape[shape.size()-2] = tile.y.windowSize;
+			tileShape[shape.size()-1] = tile.x.windowSize;
+
+			Ort::AllocatorWithDefaultOptions allocator;
+			tileInputOwners.push_back( Ort::Value::CreateTensor( allocator, tileShape.data(), tileShape.size(), type ) );
+			copyRegion(
+				static_cast<const char *>( input.GetTensorRawData() ), width, height, tile.x.windowBegin, tile.y.windowBegin,
+				static_cast<char *>( tileInputOwners.back().GetTensorMutableRawData() ), tile.x.windowSize, tile.y.windowSize, 0, 0,
+				tile.x.windowSize, tile.y.windowSize, numPlanes( shape ), elementSize( type )
+			);
+			tileInputs.push_back( tileInputOwners.back() );
+		}
+
+		vector<Ort::Value> tileOutputs;
+		for( size_t i = 0; i < outputNames.size(); ++i )
+		{
+			tileOutputs.push_back( Ort::Value( nullptr ) );
+		}
+
+		runSession( session, inputNames, tileInputs, outputNames, tileOutputs, canceller );
+
+		for( size_t i = 0; i < tileOutputs.size(); ++i )
+		{
+			const auto info = tileOutputs[i].GetTensorTypeAndShapeInfo();
+			const vector<int64_t> tileShape = info.GetShape();
+			if( tileShape.size() < 2 )
+			{
+				throw IECore::Exception( "Tiled inference requires outputs with at least two dimensions" );
+			}
+
+			const int64_t tileHeight = tileShape[tileShape.size()-2];
+			const int64_t tileWidth = tileShape[tileShape.size()-1];
+
+			if( !outputs[i] )
+			{
+				// First tile. Determine scale and allocate output.
+				if( tileHeight % tile.y.windowSize || tileWidth % tile.x.windowSize )
+				{
+					throw IECore::Exception( "Tiled inference requires output dimensions to be a whole multiple of input dimensions" );
+				}
+				outputScales[i] = V2i( tileWidth / tile.x.windowSize, tileHeight / tile.y.windowSize );
+				vector<int64_t> shape = tileShape;
+				shape[shape.size()-2] = height * outputScales[i].y;
+				shape[shape.size()-1] = width * outputScales[i].x;
+				outputData[i] = allocateOutputData( info.GetElementType(), shape, outputs[i] );
+				if( !outputData[i] )
+				{
+					Ort::AllocatorWithDefaultOptions allocator;
+					outputs[i] = Ort::Value::CreateTensor( allocator, shape.data(), shape.size(), info.GetElementType() );
+				}
+			}
+
+			const V2i &outputScale = outputScales[i];
+			const vector<int64_t> shape = outputs[i].GetTensorTypeAndShapeInfo().GetShape();
+			if(
+				tileShape.size() != shape.size() || !std::equal( shape.begin(), shape.end() - 2, tileShape.begin() ) ||
+				tileHeight != tile.y.windowSize * outputScale.y || tileWidth != tile.x.windowSize * outputScale.x
+			)
+			{
+				throw IECore::Exception( "Tiled inference produced inconsistent output shapes" );
+			}
+
+			copyRegion(
+				static_cast<const char *>( tileOutputs[i].GetTensorRawData() ), tileWidth, tileHeight,
+				( tile.x.coreBegin - tile.x.windowBegin ) * outputScale.x, ( tile.y.coreBegin - tile.y.windowBegin ) * outputScale.y,
+				static_cast<char *>( outputs[i].GetTensorMutableRawData() ), shape[shape.size()-1], shape[shape.size()-2],
+				tile.x.coreBegin * outputScale.x, tile.y.coreBegin * outputScale.y,
+				( tile.x.coreEnd - tile.x.coreBegin ) * outputScale.x, ( tile.y.coreEnd - tile.y.coreBegin ) * outputScale.y,
+				numPlanes( shape ), elementSize( info.GetElementType() )
+			);
+		}
+	};
+
+	// Process the first tile on its own, so it can allocate the outputs.
+	// The remaining tiles write to disjoint regions of the outputs, so can
+	// be processed in parallel. ONNX already does its own threading within
+	// each `Session::Run()`, but running several tiles concurrently keeps
+	// it busy during the serial parts of each run.
+
+	processTile( tiles[0] );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 1, tiles.size(), 1 ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				IECore::Canceller::check( canceller );
+				processTile( tiles[i] );
+			}
+		},
+		taskGroupContext
+	);
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -206,6 +779,8 @@ Inference::Inference( const std::string &name )
 	addChild( new StringPlug( "model" ) );
 	addChild( new ArrayPlug( "in", Plug::In, new TensorPlug( "in0" ), 0, std::numeric_limits<size_t>::max(), Plug::Default, false ) );
 	addChild( new ArrayPlug( "out", Plug::Out, new TensorPlug( "out0" ), 0, std::numeric_limits<size_t>::max(), Plug::Default, false ) );
+	addChild( new V2iPlug( "tileSize", Plug::In, V2i( 0 ), V2i( 0 ) ) );
+	addChild( new IntPlug( "tilePadding", Plug::In, 0, 0 ) );
 	addChild( new CompoundObjectPlug( "__inference", Plug::Out ) );
 }
 
@@ -291,14 +866,34 @@ const Gaffer::ArrayPlug *Inference::outPlug() const
 	return getChild<ArrayPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::V2iPlug *Inference::tileSizePlug()
+{
+	return getChild<V2iPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::V2iPlug *Inference::tileSizePlug() const
+{
+	return getChild<V2iPlug>( g_firstPlugIndex + 3 );
+}
+
+Gaffer::IntPlug *Inference::tilePaddingPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::IntPlug *Inference::tilePaddingPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 4 );
+}
+
 Gaffer::CompoundObjectPlug *Inference::inferencePlug()
 {
-	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 3);
+	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 5 );
 }
 
 const Gaffer::CompoundObjectPlug *Inference::inferencePlug() const
 {
-	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 3 );
+	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 5 );
 }
 
 void Inference::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
@@ -307,7 +902,9 @@ void Inference::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outp
 
 	if(
 		input == modelPlug() ||
-		input->parent() == inPlug()
+		input->parent() == inPlug() ||
+		input->parent() == tileSizePlug() ||
+		input == tilePaddingPlug()
 	)
 	{
 		outputs.push_back( inferencePlug() );
@@ -332,6 +929,12 @@ void Inference::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 		{
 			p->hash( h );
 		}
+		const V2i tileSize = tileSizePlug()->getValue();
+		if( tileSize.x > 0 || tileSize.y > 0 )
+		{
+			h.append( tileSize );
+			h.append( tilePaddingPlug()->getValue() );
+		}
 	}
 	else if( output->parent() == outPlug() )
 	{
@@ -370,51 +973,48 @@ void Inference::compute( Gaffer::ValuePlug *output, const Gaffer::Context *conte
 		vector<Ort::AllocatedStringPtr> outputNameOwners;
 		vector<const char *> outputNames;
 		vector<Ort::Value> outputs;
+		vector<DataPtr> outputData;
+		const V2i tileSize = tileSizePlug()->getValue();
+		const bool tiled = tileSize.x > 0 || tileSize.y > 0;
 		for( auto &p : TensorPlug::OutputRange( *outPlug() ) )
 		{
 			int outputIndex = StringAlgo::numericSuffix( p->getName().string() );
 			outputNameOwners.push_back( session.GetOutputNameAllocated( outputIndex, Ort::AllocatorWithDefaultOptions() ) );
 			outputNames.push_back( outputNameOwners.back().get() );
 			outputs.push_back( Ort::Value( nullptr ) );
+			outputData.push_back( nullptr );
+			if( !tiled )
+			{
+				// Preallocate output if its shape is known in advance. In
+				// tiled mode, `runTiledSession()` does this for us.
+				Ort::TypeInfo typeInfo = session.GetOutputTypeInfo( outputIndex );
+				auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
+				outputData.back() = allocateOutputData( tensorInfo.GetElementType(), tensorInfo.GetShape(), outputs.back() );
+			}
 		}
 
-		// Run inference asynchronously on an ONNX thread. This allows us
-		// to check for cancellation via our AsyncWaiter.
-
-		Ort::RunOptions runOptions;
-		if( useCUDA() )
+		if( tiled )
 		{
-			/// \todo Use `Env::GetEpDevices()` to get the names of all
-			/// available devices, instead of assuming a single `gpu:0` device.
-			/// We need to upgrade the ONNX version before we can do that
-			/// though.
-			runOptions.AddConfigEntry( kOrtRunOptionsConfigEnableMemoryArenaShrinkage, "gpu:0" );
+			runTiledSession( session, inputNames, inputs, outputNames, outputs, outputData, tileSize, tilePaddingPlug()->getValue(), context->canceller() );
+		}
+		else
+		{
+			runSession( session, inputNames, inputs, outputNames, outputs, context->canceller() );
 		}
-		AsyncWaiter waiter( runOptions );
-
-		session.RunAsync(
-			runOptions, inputNames.data(),
-			// The Ort C++ API wants us to pass `Ort::Value *`, but `Ort::Value`
-			// is non-copyable and the original `Ort::Value` instances are in
-			// separate TensorDatas and can't be moved. But `Ort::Value` has the
-			// same layout as `OrtValue *` (the underlying C type) so we can
-			// just reinterpret cast from the latter. Indeed, `Run()` is going
-			// to cast straight back to `OrtValue *` to call the C API!
-			reinterpret_cast<Ort::Value *>( inputs.data() ),
-			inputs.size(),
-			outputNames.data(),
-			outputs.data(),
-			outputNames.size(),
-			waiter.callback,
-			&waiter
-		);
-
-		waiter.wait( context->canceller() );
 
 		CompoundObjectPtr result = new CompoundObject;
 		for( size_t i = 0; i < outputs.size(); ++i )
 		{
-			result->members()[outPlug()->children()[i]->getName()] = new Tensor( std::move( outputs[i] ) );
+			TensorPtr tensor;
+			if( outputData[i] )
+			{
+				tensor = new Tensor( outputData[i], outputs[i].GetTensorTypeAndShapeInfo().GetShape() );
+			}
+			else
+			{
+				tensor = new Tensor( std::move( outputs[i] ) );
+			}
+			result->members()[outPlug()->children()[i]->getName()] = tensor;
 		}
 
 		static_cast<CompoundObjectPlug *>( output )->setValue( result );
@@ -342,6 +342,17 @@ IECore::ConstFloatVectorDataPtr TensorToImage::computeChannelData( const std::st
 				size_t srcIndex = BufferAlgo::index( V2i( p.x, dataWindow.max.y - p.y - 1 ), dataWindow ) * sourceStride;
 				size_t dstIndex = BufferAlgo::index( p, tileBound );
 
+				if( sourceStride == 1 )
+				{
+					// Rows are contiguous in both source and destination, so
+					// we can convert them in bulk.
+					std::transform(
+						sourceData + srcIndex, sourceData + srcIndex + validTileBound.size().x, dstData + dstIndex,
+						[] ( const auto &v ) { return static_cast<float>( v ); }
+					);
+					continue;
+				}
+
 				for( int x = validTileBound.min.x; x < validTileBound.max.x; ++x )
 				{
 					dstData[dstIndex++] = static_cast<float>( sourceData[srcIndex] );
@@ -72,6 +72,7 @@ OSLImage::OSLImage( const std::string &name )
 	storeIndexOfNextChild( g_firstPlugIndex );
 
 	addChild( new GafferImage::FormatPlug( "defaultFormat" ) );
+	addChild( new BoolPlug( "useBatchedShading", Plug::In, true ) );
 	addChild( new GafferScene::ShaderPlug( "__shader", Plug::In, Plug::Default & ~Plug::Serialisable ) );
 
 	addChild( new Gaffer::ObjectPlug( "__shading", Gaffer::Plug::Out, new CompoundData() ) );
@@ -109,74 +110,84 @@ const GafferImage::FormatPlug *OSLImage::defaultFormatPlug() const
 	return getChild<GafferImage::FormatPlug>( g_firstPlugIndex );
 }
 
+Gaffer::BoolPlug *OSLImage::useBatchedShadingPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::BoolPlug *OSLImage::useBatchedShadingPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 1 );
+}
+
 GafferScene::ShaderPlug *OSLImage::shaderPlug()
 {
-	return getChild<GafferScene::ShaderPlug>( g_firstPlugIndex + 1 );
+	return getChild<GafferScene::ShaderPlug>( g_firstPlugIndex + 2 );
 }
 
 const GafferScene::ShaderPlug *OSLImage::shaderPlug() const
 {
-	return getChild<GafferScene::ShaderPlug>( g_firstPlugIndex + 1 );
+	return getChild<GafferScene::ShaderPlug>( g_firstPlugIndex + 2 );
 }
 
 Gaffer::ObjectPlug *OSLImage::shadingPlug()
 {
-	return getChild<ObjectPlug>( g_firstPlugIndex + 2 );
+	return getChild<ObjectPlug>( g_firstPlugIndex + 3 );
 }
 
 const Gaffer::ObjectPlug *OSLImage::shadingPlug() const
 {
-	return getChild<ObjectPlug>( g_firstPlugIndex + 2 );
+	return getChild<ObjectPlug>( g_firstPlugIndex + 3 );
 }
 
 Gaffer::StringVectorDataPlug *OSLImage::affectedChannelsPlug()
 {
-	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 3 );
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 4 );
 }
 
 const Gaffer::StringVectorDataPlug *OSLImage::affectedChannelsPlug() const
 {
-	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 3 );
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 4 );
 }
 
 Gaffer::Plug *OSLImage::channelsPlug()
 {
-	return getChild<Gaffer::Plug>( g_firstPlugIndex + 4 );
+	return getChild<Gaffer::Plug>( g_firstPlugIndex + 5 );
 }
 
 const Gaffer::Plug *OSLImage::channelsPlug() const
 {
-	return getChild<Gaffer::Plug>( g_firstPlugIndex + 4 );
+	return getChild<Gaffer::Plug>( g_firstPlugIndex + 5 );
 }
 
 GafferOSL::OSLCode *OSLImage::oslCode()
 {
-	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 5 );
+	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 6 );
 }
 
 const GafferOSL::OSLCode *OSLImage::oslCode() const
 {
-	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 5 );
+	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 6 );
 }
 
 GafferImage::Constant *OSLImage::defaultConstant()
 {
-	return getChild<GafferImage::Constant>( g_firstPlugIndex + 6 );
+	return getChild<GafferImage::Constant>( g_firstPlugIndex + 7 );
 }
 
 const GafferImage::Constant *OSLImage::defaultConstant() const
 {
-	return getChild<GafferImage::Constant>( g_firstPlugIndex + 6 );
+	return getChild<GafferImage::Constant>( g_firstPlugIndex + 7 );
 }
 
 GafferImage::ImagePlug *OSLImage::defaultInPlug()
 {
-	return getChild<GafferImage::ImagePlug>( g_firstPlugIndex + 7 );
+	return getChild<GafferImage::ImagePlug>( g_firstPlugIndex + 8 );
 }
 
 const GafferImage::ImagePlug *OSLImage::defaultInPlug() const
 {
-	return getChild<GafferImage::ImagePlug>( g_firstPlugIndex + 7 );
+	return getChild<GafferImage::ImagePlug>( g_firstPlugIndex + 8 );
 }
 
 const GafferImage::ImagePlug *OSLImage::defaultedInPlug() const
@@ -198,6 +209,7 @@ void OSLImage::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outpu
 
 	if(
 		input == shaderPlug() ||
+		input == useBatchedShadingPlug() ||
 		input == inPlug()->formatPlug() ||
 		input == defaultInPlug()->formatPlug() ||
 		input == inPlug()->channelNamesPlug() ||
@@ -498,6 +510,7 @@ void OSLImage::hashShading( const Gaffer::Context *context, IECore::MurmurHash &
 		defaultedInPlug()->formatPlug()->hash( h );
 		channelNamesData = defaultedInPlug()->channelNamesPlug()->getValue();
 		deep = defaultedInPlug()->deepPlug()->getValue();
+		useBatchedShadingPlug()->hash( h );
 	}
 
 	if( deep )
@@ -538,11 +551,13 @@ IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *co
 	Format format;
 	ConstStringVectorDataPtr channelNamesData;
 	bool deep;
+	bool useBatchedShading;
 	{
 		ImagePlug::GlobalScope c( context );
 		format = defaultedInPlug()->formatPlug()->getValue();
 		channelNamesData = defaultedInPlug()->channelNamesPlug()->getValue();
 		deep = defaultedInPlug()->deepPlug()->getValue();
+		useBatchedShading = useBatchedShadingPlug()->getValue();
 	}
 
 	CompoundDataPtr shadingPoints = new CompoundData();
@@ -630,7 +645,10 @@ IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *co
 	shadingPoints->writable()["v"] = vData;
 
 
-	CompoundDataPtr result = shadingEngine->shade( shadingPoints.get() );
+	CompoundDataPtr result = shadingEngine->shade(
+		shadingPoints.get(), ShadingEngine::Transforms(), ShadingEngine::PointClouds(), ShadingEngine::Indices(),
+		useBatchedShading
+	);
 
 	// remove results that aren't suitable to become channels
 	for( CompoundDataMap::iterator it = result->writable().begin(); it != result->writable().end();  )
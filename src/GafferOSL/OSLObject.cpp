@@ -69,21 +69,19 @@ size_t OSLObject::g_firstPlugIndex;
 namespace
 {
 
-CompoundDataPtr prepareShadingPoints( const Primitive *primitive, const ShadingEngine *shadingEngine, const CompoundObject *gafferAttributes = nullptr )
+CompoundDataPtr prepareShadingPoints( const Primitive *primitive, const ShadingEngine *shadingEngine, ShadingEngine::Indices &indices, const CompoundObject *gafferAttributes = nullptr )
 {
 	CompoundDataPtr shadingPoints = new CompoundData;
 	for( PrimitiveVariableMap::const_iterator it = primitive->variables.begin(), eIt = primitive->variables.end(); it != eIt; ++it )
 	{
-		// todo: consider passing something like IndexedView to the ShadingEngine to avoid the expansion of indexed data.
 		if( shadingEngine->needsAttribute( it->first ) )
 		{
+			// Indexed data is passed through as-is along with its indices,
+			// so that memory usage remains proportional to the input.
+			shadingPoints->writable()[it->first] = boost::const_pointer_cast<Data>( it->second.data );
 			if( it->second.indices )
 			{
-				shadingPoints->writable()[it->first] = it->second.expandedData();
-			}
-			else
-			{
-				shadingPoints->writable()[it->first] = boost::const_pointer_cast<Data>( it->second.data );
+				indices[it->first] = it->second.indices;
 			}
 		}
 	}
@@ -232,6 +230,7 @@ OSLObject::OSLObject( const std::string &name )
 		)
 	);
 	addChild( new BoolPlug( "ignoreMissingSourceLocations" ) );
+	addChild( new BoolPlug( "useBatchedShading", Plug::In, true ) );
 	addChild( new ScenePlug( "__resampledIn", Plug::In, Plug::Default & ~Plug::Serialisable ) );
 	addChild( new StringPlug( "__resampleNames", Plug::Out ) );
 	addChild( new Plug( "primitiveVariables", Plug::In, Plug::Default & ~Plug::AcceptsInputs ) );
@@ -326,44 +325,54 @@ const Gaffer::BoolPlug *OSLObject::ignoreMissingSourceLocationsPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex + 6 );
 }
 
+Gaffer::BoolPlug *OSLObject::useBatchedShadingPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 7 );
+}
+
+const Gaffer::BoolPlug *OSLObject::useBatchedShadingPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 7 );
+}
+
 ScenePlug *OSLObject::resampledInPlug()
 {
-	return getChild<ScenePlug>( g_firstPlugIndex + 7 );
+	return getChild<ScenePlug>( g_firstPlugIndex + 8 );
 }
 
 const ScenePlug *OSLObject::resampledInPlug() const
 {
-	return getChild<ScenePlug>( g_firstPlugIndex + 7 );
+	return getChild<ScenePlug>( g_firstPlugIndex + 8 );
 }
 
 StringPlug *OSLObject::resampledNamesPlug()
 {
-	return getChild<StringPlug>( g_firstPlugIndex + 8 );
+	return getChild<StringPlug>( g_firstPlugIndex + 9 );
 }
 
 const StringPlug *OSLObject::resampledNamesPlug() const
 {
-	return getChild<StringPlug>( g_firstPlugIndex + 8 );
+	return getChild<StringPlug>( g_firstPlugIndex + 9 );
 }
 
 Gaffer::Plug *OSLObject::primitiveVariablesPlug()
 {
-	return getChild<Gaffer::Plug>( g_firstPlugIndex + 9 );
+	return getChild<Gaffer::Plug>( g_firstPlugIndex + 10 );
 }
 
 const Gaffer::Plug *OSLObject::primitiveVariablesPlug() const
 {
-	return getChild<Gaffer::Plug>( g_firstPlugIndex + 9 );
+	return getChild<Gaffer::Plug>( g_firstPlugIndex + 10 );
 }
 
 GafferOSL::OSLCode *OSLObject::oslCode()
 {
-	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 10 );
+	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 11 );
 }
 
 const GafferOSL::OSLCode *OSLObject::oslCode() const
 {
-	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 10 );
+	return getChild<GafferOSL::OSLCode>( g_firstPlugIndex + 11 );
 }
 
 void OSLObject::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
@@ -412,6 +421,7 @@ bool OSLObject::affectsProcessedObject( const Gaffer::Plug *input ) const
 		input == resampledInPlug()->objectPlug() ||
 		sourceLocationsPlug()->isAncestorOf( input ) ||
 		input == ignoreMissingSourceLocationsPlug() ||
+		input == useBatchedShadingPlug() ||
 		( sourceLocationsUseTransform && input == sourcePlug()->transformPlug() ) ||
 		( sourceLocationsUseObject && input == sourcePlug()->objectPlug() ) ||
 		( haveSourceLocations && input == sourcePlug()->existsPlug() )
@@ -457,6 +467,7 @@ void OSLObject::hashProcessedObject( const ScenePath &path, const Gaffer::Contex
 	}
 
 	ignoreMissingSourceLocationsPlug()->hash( h );
+	useBatchedShadingPlug()->hash( h );
 
 	for( const auto &p : SourceLocationPlug::Range( *sourceLocationsPlug() ) )
 	{
@@ -520,7 +531,8 @@ IECore::ConstObjectPtr OSLObject::computeProcessedObject( const ScenePath &path,
 
 
 	IECoreScene::ConstPrimitivePtr resampledObject = IECore::runTimeCast<const IECoreScene::Primitive>( resampledInPlug()->objectPlug()->getValue() );
-	CompoundDataPtr shadingPoints = prepareShadingPoints( resampledObject.get(), shadingEngine.get(), gafferAttributes.get() );
+	ShadingEngine::Indices indices;
+	CompoundDataPtr shadingPoints = prepareShadingPoints( resampledObject.get(), shadingEngine.get(), indices, gafferAttributes.get() );
 
 	PrimitivePtr outputPrimitive = inputPrimitive->copy();
 
@@ -592,7 +604,7 @@ IECore::ConstObjectPtr OSLObject::computeProcessedObject( const ScenePath &path,
 		}
 	}
 
-	CompoundDataPtr shadedPoints = shadingEngine->shade( shadingPoints.get(), transforms, pointClouds );
+	CompoundDataPtr shadedPoints = shadingEngine->shade( shadingPoints.get(), transforms, pointClouds, indices, useBatchedShadingPlug()->getValue() );
 	for( CompoundDataMap::const_iterator it = shadedPoints->readable().begin(), eIt = shadedPoints->readable().end(); it != eIt; ++it )
 	{
 
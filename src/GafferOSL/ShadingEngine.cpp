@@ -47,6 +47,7 @@
 #include "IECore/KDTree.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/SimpleTypedData.h"
+#include "IECore/Timer.h"
 #include "IECore/VectorTypedData.h"
 
 #include "OSL/genclosure.h"
@@ -78,8 +79,12 @@
 
 #include "fmt/format.h"
 
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 
 using namespace std;
@@ -106,6 +111,32 @@ namespace
 // it affects the conversion routines.
 int g_shadingSystemBatchSize = 0;
 
+// True while the current thread is executing batched shading. OSL represents
+// strings differently for batched and non-batched execution, and batching may
+// be turned off for individual calls to `shade()`, so the conversion routines
+// can't rely on `g_shadingSystemBatchSize` alone.
+thread_local bool g_batchedExecution = false;
+
+struct BatchedExecutionScope
+{
+
+	BatchedExecutionScope( bool batched )
+		:	m_previous( g_batchedExecution )
+	{
+		g_batchedExecution = batched;
+	}
+
+	~BatchedExecutionScope()
+	{
+		g_batchedExecution = m_previous;
+	}
+
+	private :
+
+		const bool m_previous;
+
+};
+
 template<typename T>
 struct TypeDescFromType
 {
@@ -309,7 +340,7 @@ bool convertValueToOSL( void *dst, TypeDesc dstType, const void *src, TypeDesc s
 			return true;
 		}
 #if OSL_LIBRARY_VERSION_CODE >= 11400
-		if( g_shadingSystemBatchSize > 1 )
+		if( g_batchedExecution )
 		{
 			*(ustring *)dst = *(const char**)src;
 		}
@@ -511,6 +542,7 @@ class RenderState
 			const IECore::CompoundData *shadingPoints,
 			const ShadingEngine::Transforms &transforms,
 			const ShadingEngine::PointClouds &pointClouds,
+			const ShadingEngine::Indices &indices,
 			const std::vector<InternedString> &contextVariablesNeeded,
 			const Gaffer::Context *context
 		)
@@ -531,6 +563,12 @@ class RenderState
 						// convertValueToOSL() in get_userdata().
 						userData.dataView.type.unarray();
 					}
+					auto indicesIt = indices.find( it->first );
+					if( indicesIt != indices.end() && indicesIt->second && !indicesIt->second->readable().empty() )
+					{
+						userData.indices = indicesIt->second->readable().data();
+						userData.numIndices = indicesIt->second->readable().size();
+					}
 					m_userData.insert( make_pair( ustringhash( it->first.c_str() ), userData ) );
 				}
 			}
@@ -603,7 +641,7 @@ class RenderState
 			}
 
 			const char *src = static_cast<const char *>( it->second.dataView.data );
-			src += std::min( pointIndex, it->second.numValues - 1 ) * it->second.dataView.type.elementsize();
+			src += it->second.element( pointIndex ) * it->second.dataView.type.elementsize();
 
 			return convertValueToOSL( value, type, src, it->second.dataView.type );
 		}
@@ -644,15 +682,15 @@ class RenderState
 				return Mask<WidthT>( false );
 			}
 
-			const char *src = static_cast<const char *>( it->second.dataView.data );
-			const TypeDesc &sourceType = it->second.dataView.type;
+			const UserData &userData = it->second;
+			const char *src = static_cast<const char *>( userData.dataView.data );
+			const TypeDesc &sourceType = userData.dataView.type;
 			size_t elementSize = sourceType.elementsize();
-			size_t maxElement = it->second.numValues - 1;
-			if( it->second.dataView.type == wval.type() && wval.type().basetype != TypeDesc::STRING )
+			if( userData.dataView.type == wval.type() && wval.type().basetype != TypeDesc::STRING )
 			{
 				maskedDataInitWithZeroDerivs( wval );
-				wval.mask().foreach ([&wval, pointIndex, src, elementSize, maxElement ](ActiveLane lane) -> void {
-					int i = std::min( pointIndex + lane, maxElement );
+				wval.mask().foreach ([&wval, &userData, pointIndex, src, elementSize ](ActiveLane lane) -> void {
+					const size_t i = userData.element( pointIndex + lane );
 					wval.assign_val_lane_from_scalar( lane, src + i * elementSize );
 				});
 			}
@@ -675,10 +713,10 @@ class RenderState
 
 				void *tempBuffer = alloca( neededSize );
 				wval.mask().foreach (
-					[&wval, pointIndex, src, elementSize, maxElement, &sourceType, &tempBuffer]
+					[&wval, &userData, pointIndex, src, elementSize, &sourceType, &tempBuffer]
 					(ActiveLane lane) -> void
 					{
-						int i = std::min( pointIndex + lane, maxElement );
+						const size_t i = userData.element( pointIndex + lane );
 						convertValueToOSL( tempBuffer, wval.type(), src + i * elementSize, sourceType );
 						wval.assign_val_lane_from_scalar( lane, tempBuffer );
 					}
@@ -726,6 +764,19 @@ class RenderState
 		{
 			IECoreImage::OpenImageIOAlgo::DataView dataView;
 			size_t numValues;
+			// Non-null for indexed variables, which we look up
+			// on demand rather than expanding.
+			const int *indices = nullptr;
+			size_t numIndices = 0;
+
+			size_t element( size_t pointIndex ) const
+			{
+				if( indices )
+				{
+					return indices[std::min( pointIndex, numIndices - 1 )];
+				}
+				return std::min( pointIndex, numValues - 1 );
+			}
 		};
 
 		struct ContextData
@@ -1261,7 +1312,7 @@ struct StringParameter
 
 	ustring asUString() const
 	{
-		if( g_shadingSystemBatchSize == 1 )
+		if( !g_batchedExecution )
 		{
 			ustringhash h;
 			memcpy( &h, storage, sizeof( ustringhash ) );
@@ -1303,7 +1354,10 @@ struct DebugParameters
 
 // Must be held in order to modify the shading system.
 // Should not be acquired before calling shadingSystem(),
-// since shadingSystem() itself will use it.
+// since shadingSystem() itself will use it. This includes
+// declaring shader groups, since `ShaderGroupBegin()` and
+// `ShaderGroupEnd()` change the current group of the
+// ShadingSystem.
 using ShadingSystemWriteMutex = tbb::spin_mutex;
 ShadingSystemWriteMutex g_shadingSystemWriteMutex;
 
@@ -1402,9 +1456,13 @@ OSL::ShadingSystem *shadingSystem( int *batchSize = nullptr )
 
 #if OSL_USE_BATCHED
 	bool requestBatch = true;
+	bool allowBatchSize16 = true;
 	if( const char *requestBatchVar = getenv( "GAFFEROSL_USE_BATCHED" ) )
 	{
 		requestBatch = std::string( requestBatchVar ) != "0";
+		// Allow 8-wide batches to be requested explicitly, so that
+		// we can compare performance with 16-wide batches.
+		allowBatchSize16 = std::string( requestBatchVar ) != "8";
 	}
 
 	// If we wanted to request fused-multiply-add, we would request it here with:
@@ -1417,7 +1475,7 @@ OSL::ShadingSystem *shadingSystem( int *batchSize = nullptr )
 	// farm ... getting a subtle flicker because frames that hit out of date farm blades
 	// render ever-so-slightly darker is not much fun.
 
-	if( requestBatch && g_shadingSystem->configure_batch_execution_at( 16 ) )
+	if( requestBatch && allowBatchSize16 && g_shadingSystem->configure_batch_execution_at( 16 ) )
 	{
 		g_shadingSystemBatchSize = 16;
 	}
@@ -1688,7 +1746,7 @@ struct ThreadInfo
 namespace
 {
 
-void declareParameters( const CompoundDataMap &parameters, ShadingSystem *shadingSystem )
+void declareParameters( const CompoundDataMap &parameters, ShaderGroup &shaderGroup, ShadingSystem *shadingSystem )
 {
 	for( CompoundDataMap::const_iterator it = parameters.begin(), eIt = parameters.end(); it != eIt; ++it )
 	{
@@ -1704,7 +1762,7 @@ void declareParameters( const CompoundDataMap &parameters, ShadingSystem *shadin
 				// so VECTOR is a more useful default.
 				dataView.type.vecsemantics = TypeDesc::VECTOR;
 			}
-			shadingSystem->Parameter( it->first.c_str(), dataView.type, dataView.data );
+			shadingSystem->Parameter( shaderGroup, it->first.c_str(), dataView.type, dataView.data );
 		}
 		else
 		{
@@ -1728,6 +1786,8 @@ T uniformValue( const IECore::CompoundData *points, const char *name )
 	}
 }
 
+const std::array<InternedString, 5> g_varyingGlobals = { "P", "N", "u", "v", "uv" };
+
 template<typename T>
 const T *varyingValue( const IECore::CompoundData *points, const char *name )
 {
@@ -1743,75 +1803,32 @@ const T *varyingValue( const IECore::CompoundData *points, const char *name )
 	}
 }
 
-} // namespace
-
-ShadingEngine::ShadingEngine( const IECoreScene::ShaderNetwork *shaderNetwork ) : ShadingEngine( shaderNetwork->copy() )
-{
-}
-
-
-ShadingEngine::ShadingEngine( IECoreScene::ShaderNetworkPtr &&shaderNetwork )
-	:	m_hash( shaderNetwork->Object::hash() ), m_timeNeeded( false ), m_unknownAttributesNeeded( false ), m_hasDeformation( false )
+// Shader groups are immutable once declared, so we share them between
+// all ShadingEngines constructed from the same network. This means that
+// declaration, optimisation and JIT compilation are paid for only once
+// per network, rather than once per ShadingEngine.
+struct CompiledShaderGroup
 {
-	IECoreScene::ShaderNetworkAlgo::convertToOSLConventions( shaderNetwork.get(), OSL_VERSION );
-
-	ShadingSystem *shadingSystem = ::shadingSystem();
-
-	{
-		ShadingSystemWriteMutex::scoped_lock shadingSystemWriteLock( g_shadingSystemWriteMutex );
-		m_shaderGroupRef = new ShaderGroupRef( shadingSystem->ShaderGroupBegin() );
-		std::vector<std::string> invalidShaders;
-
-		ShaderNetworkAlgo::depthFirstTraverse(
-			shaderNetwork.get(),
-			[shadingSystem, &invalidShaders] ( const ShaderNetwork *shaderNetwork, const InternedString &handle ) {
-
-				// Check for invalid (non-OSL) shaders. We stop declaring shaders if any
-				// have been found, but complete the traversal so that we can compile a
-				// full list of invalid shaders.
-
-				const Shader *shader = shaderNetwork->getShader( handle );
-				if( !boost::starts_with( shader->getType(), "osl:" ) )
-				{
-					invalidShaders.push_back( shader->getName() + " (" + shader->getType() + ")" );
-				}
-
-				if( invalidShaders.size() )
-				{
-					return;
-				}
 
-				// Declare this shader along with its parameters and connections.
+	ShaderGroupRef shaderGroup;
 
-				declareParameters( shader->parametersData()->readable(), shadingSystem );
-				shadingSystem->Shader( "surface", shader->getName().c_str(), handle.c_str() );
+	bool timeNeeded = false;
+	std::vector<InternedString> contextVariablesNeeded;
+	boost::container::flat_set<std::string> attributesNeeded;
+	bool unknownAttributesNeeded = false;
+	bool hasDeformation = false;
 
-				for( const auto &c : shaderNetwork->inputConnections( handle ) )
-				{
-					shadingSystem->ConnectShaders(
-						c.source.shader.c_str(), c.source.name.c_str(),
-						c.destination.shader.c_str(), c.destination.name.c_str()
-					);
-				}
-			}
-		);
-
-		shadingSystem->ShaderGroupEnd();
+	// Set if the group couldn't be JIT compiled for batched
+	// execution, in which case we always use non-batched shading.
+	mutable std::atomic_bool batchedShadingFailed{ false };
 
-		if( !invalidShaders.empty() )
-		{
-			std::string exceptionMessage = "The following shaders can't be used as they are not OSL shaders: ";
-			throw Exception( exceptionMessage + boost::algorithm::join( invalidShaders, ", " ) );
-		}
-	}
+};
 
-	queryShaderGroup();
-}
+using CompiledShaderGroupPtr = std::shared_ptr<const CompiledShaderGroup>;
 
-void ShadingEngine::queryShaderGroup()
+void queryShaderGroup( ShadingSystem *shadingSystem, CompiledShaderGroup &compiledGroup )
 {
-	ShadingSystem *shadingSystem = ::shadingSystem();
-	ShaderGroup &shaderGroup = **static_cast<ShaderGroupRef *>( m_shaderGroupRef );
+	ShaderGroup &shaderGroup = *compiledGroup.shaderGroup;
 
 	// Globals
 
@@ -1825,10 +1842,10 @@ void ShadingEngine::queryShaderGroup()
 		{
 			if( globalsNames[i] == "time" )
 			{
-				m_timeNeeded = true;
+				compiledGroup.timeNeeded = true;
 			}
 
-			m_attributesNeeded.insert( globalsNames[i].string() );
+			compiledGroup.attributesNeeded.insert( globalsNames[i].string() );
 		}
 	}
 
@@ -1836,7 +1853,7 @@ void ShadingEngine::queryShaderGroup()
 
 	int unknownAttributesNeeded = 0;
 	shadingSystem->getattribute(  &shaderGroup, "unknown_attributes_needed", unknownAttributesNeeded );
-	m_unknownAttributesNeeded = static_cast<bool> (unknownAttributesNeeded);
+	compiledGroup.unknownAttributesNeeded = static_cast<bool> (unknownAttributesNeeded);
 
 	int numAttributes = 0;
 	shadingSystem->getattribute( &shaderGroup, "num_attributes_needed", numAttributes );
@@ -1851,11 +1868,11 @@ void ShadingEngine::queryShaderGroup()
 		{
 			if( scopeNames[i] == g_contextVariableAttributeScope )
 			{
-				m_contextVariablesNeeded.push_back( attributeNames[i].string() );
+				compiledGroup.contextVariablesNeeded.push_back( attributeNames[i].string() );
 			}
 			else
 			{
-				m_attributesNeeded.insert( attributeNames[i].string()  );
+				compiledGroup.attributesNeeded.insert( attributeNames[i].string()  );
 			}
 		}
 	}
@@ -1866,7 +1883,7 @@ void ShadingEngine::queryShaderGroup()
 	shadingSystem->getattribute(  &shaderGroup, "unknown_closures_needed", unknownClosuresNeeded );
 	if( unknownClosuresNeeded )
 	{
-		m_hasDeformation = true;
+		compiledGroup.hasDeformation = true;
 	}
 
 	int numClosures = 0;
@@ -1879,16 +1896,193 @@ void ShadingEngine::queryShaderGroup()
 		{
 			if( closureNames[i] == "deformation" )
 			{
-				m_hasDeformation = true;
+				compiledGroup.hasDeformation = true;
 				break;
 			}
 		}
 	}
 }
 
+std::unique_ptr<CompiledShaderGroup> compileShaderGroup( ShaderNetwork *shaderNetwork )
+{
+	IECore::Timer timer;
+
+	IECoreScene::ShaderNetworkAlgo::convertToOSLConventions( shaderNetwork, OSL_VERSION );
+
+	ShadingSystem *shadingSystem = ::shadingSystem();
+
+	// `ShaderGroupBegin()` changes the "current" group of the ShadingSystem,
+	// so we must hold `g_shadingSystemWriteMutex` until `ShaderGroupEnd()`,
+	// even though we use the overloads that take an explicit ShaderGroup.
+	// Declaration is cheap compared to optimisation, which is triggered by
+	// `queryShaderGroup()` below, and happens without the lock.
+
+	auto result = std::make_unique<CompiledShaderGroup>();
+	std::vector<std::string> invalidShaders;
+	{
+		ShadingSystemWriteMutex::scoped_lock shadingSystemWriteLock( g_shadingSystemWriteMutex );
+		result->shaderGroup = shadingSystem->ShaderGroupBegin();
+		ShaderGroup &shaderGroup = *result->shaderGroup;
+
+		ShaderNetworkAlgo::depthFirstTraverse(
+			shaderNetwork,
+			[shadingSystem, &shaderGroup, &invalidShaders] ( const ShaderNetwork *shaderNetwork, const InternedString &handle ) {
+
+				// Check for invalid (non-OSL) shaders. We stop declaring shaders if any
+				// have been found, but complete the traversal so that we can compile a
+				// full list of invalid shaders.
+
+				const Shader *shader = shaderNetwork->getShader( handle );
+				if( !boost::starts_with( shader->getType(), "osl:" ) )
+				{
+					invalidShaders.push_back( shader->getName() + " (" + shader->getType() + ")" );
+				}
+
+				if( invalidShaders.size() )
+				{
+					return;
+				}
+
+				// Declare this shader along with its parameters and connections.
+
+				declareParameters( shader->parametersData()->readable(), shaderGroup, shadingSystem );
+				shadingSystem->Shader( shaderGroup, "surface", shader->getName().c_str(), handle.c_str() );
+
+				for( const auto &c : shaderNetwork->inputConnections( handle ) )
+				{
+					shadingSystem->ConnectShaders(
+						shaderGroup,
+						c.source.shader.c_str(), c.source.name.c_str(),
+						c.destination.shader.c_str(), c.destination.name.c_str()
+					);
+				}
+			}
+		);
+
+		shadingSystem->ShaderGroupEnd( shaderGroup );
+	}
+
+	if( !invalidShaders.empty() )
+	{
+		std::string exceptionMessage = "The following shaders can't be used as they are not OSL shaders: ";
+		throw Exception( exceptionMessage + boost::algorithm::join( invalidShaders, ", " ) );
+	}
+
+	// Querying the group triggers OSL's optimisation of the network, which
+	// is the bulk of the compilation cost.
+	queryShaderGroup( shadingSystem, *result );
+
+	msg(
+		Msg::Debug, "ShadingEngine",
+		fmt::format(
+			"Compiled shader group for network \"{}\" ({} shaders) in {}s",
+			shaderNetwork->getOutput().shader.string(), shaderNetwork->size(), timer.stop()
+		)
+	);
+
+	return result;
+}
+
+// Registry of the groups currently in use, keyed on the network hash. This
+// is separate from the ShadingEngine cache in OSLShader.cpp, which is keyed
+// on the shader plug and substitutions rather than the network, and which
+// is bypassed entirely by clients that construct ShadingEngines directly.
+// Groups are held weakly, so that they are destroyed along with the last
+// ShadingEngine using them, and the registry never retains JIT-compiled
+// code for networks that are no longer needed.
+class CompiledShaderGroupRegistry
+{
+
+	public :
+
+		CompiledShaderGroupPtr get( const IECore::MurmurHash &hash, ShaderNetwork *shaderNetwork )
+		{
+			EntryPtr entry;
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+				EntryPtr &e = m_entries[hash];
+				if( !e )
+				{
+					e = std::make_shared<Entry>();
+				}
+				entry = e;
+			}
+
+			// The per-entry lock ensures that concurrent requests for the same
+			// network wait for a single compilation, while requests for different
+			// networks proceed in parallel.
+			std::lock_guard<std::mutex> lock( entry->mutex );
+			if( CompiledShaderGroupPtr result = entry->group.lock() )
+			{
+				return result;
+			}
+
+			CompiledShaderGroupPtr result(
+				compileShaderGroup( shaderNetwork ).release(),
+				[this, hash] ( const CompiledShaderGroup *group ) {
+					delete group;
+					erase( hash );
+				}
+			);
+			entry->group = result;
+			return result;
+		}
+
+	private :
+
+		void erase( const IECore::MurmurHash &hash )
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			auto it = m_entries.find( hash );
+			// Leave the entry alone if another thread is currently using it,
+			// or has already replaced the group we just destroyed.
+			if( it != m_entries.end() && it->second.use_count() == 1 && it->second->group.expired() )
+			{
+				m_entries.erase( it );
+			}
+		}
+
+		struct Entry
+		{
+			std::mutex mutex;
+			std::weak_ptr<const CompiledShaderGroup> group;
+		};
+		using EntryPtr = std::shared_ptr<Entry>;
+
+		std::mutex m_mutex;
+		boost::unordered_map<IECore::MurmurHash, EntryPtr> m_entries;
+
+};
+
+CompiledShaderGroupRegistry &compiledShaderGroupRegistry()
+{
+	// Deliberately leaked, since groups may outlive static destruction.
+	static CompiledShaderGroupRegistry *g_registry = new CompiledShaderGroupRegistry;
+	return *g_registry;
+}
+
+} // namespace
+
+ShadingEngine::ShadingEngine( const IECoreScene::ShaderNetwork *shaderNetwork ) : ShadingEngine( shaderNetwork->copy() )
+{
+}
+
+
+ShadingEngine::ShadingEngine( IECoreScene::ShaderNetworkPtr &&shaderNetwork )
+	:	m_hash( shaderNetwork->Object::hash() )
+{
+	CompiledShaderGroupPtr compiledGroup = compiledShaderGroupRegistry().get( m_hash, shaderNetwork.get() );
+
+	m_timeNeeded = compiledGroup->timeNeeded;
+	m_contextVariablesNeeded = compiledGroup->contextVariablesNeeded;
+	m_attributesNeeded = compiledGroup->attributesNeeded;
+	m_unknownAttributesNeeded = compiledGroup->unknownAttributesNeeded;
+	m_hasDeformation = compiledGroup->hasDeformation;
+	m_shaderGroup = compiledGroup;
+}
+
 ShadingEngine::~ShadingEngine()
 {
-	delete static_cast<ShaderGroupRef *>( m_shaderGroupRef );
 }
 
 void ShadingEngine::hash( IECore::MurmurHash &h ) const
@@ -1935,6 +2129,7 @@ IECore::CompoundDataPtr executeShade( const ExecuteShadeParameters &params, cons
 	// Iterate over the input points, doing the shading as we go
 	auto f = [&params, &renderState, &shaderGroup, &shadingSystem, &results]( const tbb::blocked_range<size_t> &r )
 	{
+		BatchedExecutionScope batchedExecutionScope( false );
 		ThreadInfo &threadInfo = params.threadInfoCache.local();
 
 		ThreadRenderState threadRenderState( renderState );
@@ -1993,15 +2188,21 @@ IECore::CompoundDataPtr executeShade( const ExecuteShadeParameters &params, cons
 template< int WidthT >
 IECore::CompoundDataPtr executeShadeBatched( const ExecuteShadeParameters &params, const RenderState &renderState, ShaderGroup &shaderGroup, ShadingSystem::BatchedExecutor<WidthT> &executor )
 {
+	// Compile for batched execution, returning null if this isn't
+	// possible, so that the caller can fall back to `executeShade()`.
+	if( !executor.jit_group( &shaderGroup, params.threadInfoCache.local().shadingContext ) )
+	{
+		return nullptr;
+	}
+
 	// Allocate data for the result
 	ShadingResults results( params.numPoints );
 
-	executor.jit_group( &shaderGroup, params.threadInfoCache.local().shadingContext );
-
 	// Iterate over the input points, doing the shading as we go
 
 	auto f = [&params, &renderState, &shaderGroup, &executor, &results]( const tbb::blocked_range<size_t> &r )
 	{
+		BatchedExecutionScope batchedExecutionScope( true );
 		ThreadInfo &threadInfo = params.threadInfoCache.local();
 
 		ThreadRenderState threadRenderState( renderState );
@@ -2113,7 +2314,49 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 
 IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points, const Transforms &transforms, const PointClouds &pointClouds ) const
 {
-	ShaderGroup &shaderGroup = **static_cast<ShaderGroupRef *>( m_shaderGroupRef );
+	return shade( points, transforms, pointClouds, Indices() );
+}
+
+IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points, const Transforms &transforms, const PointClouds &pointClouds, const Indices &indices, bool useBatchedShading ) const
+{
+	// Shader globals are read directly from contiguous arrays, so any that
+	// are indexed must be expanded. All other indexed variables are looked
+	// up on demand by the RenderState.
+
+	CompoundDataPtr pointsWithExpandedGlobals;
+	Indices remainingIndices;
+	const Indices *userDataIndices = &indices;
+	for( const auto &name : g_varyingGlobals )
+	{
+		auto indicesIt = indices.find( name );
+		if( indicesIt == indices.end() || !indicesIt->second )
+		{
+			continue;
+		}
+		auto pointsIt = points->readable().find( name );
+		if( pointsIt == points->readable().end() )
+		{
+			continue;
+		}
+		if( !pointsWithExpandedGlobals )
+		{
+			pointsWithExpandedGlobals = new CompoundData( points->readable() );
+			remainingIndices = indices;
+			userDataIndices = &remainingIndices;
+		}
+		pointsWithExpandedGlobals->writable()[name] = PrimitiveVariable(
+			PrimitiveVariable::Vertex, pointsIt->second, boost::const_pointer_cast<IntVectorData>( indicesIt->second )
+		).expandedData();
+		remainingIndices.erase( name );
+	}
+
+	if( pointsWithExpandedGlobals )
+	{
+		points = pointsWithExpandedGlobals.get();
+	}
+
+	const CompiledShaderGroup *compiledGroup = static_cast<const CompiledShaderGroup *>( m_shaderGroup.get() );
+	ShaderGroup &shaderGroup = *compiledGroup->shaderGroup;
 
 	ExecuteShadeParameters shadeParameters;
 	int batchSize;
@@ -2178,27 +2421,40 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 	// Add a RenderState to the ShaderGlobals. This will
 	// get passed to our RendererServices queries.
 
-	RenderState renderState( points, transforms, pointClouds, m_contextVariablesNeeded, context );
+	RenderState renderState( points, transforms, pointClouds, *userDataIndices, m_contextVariablesNeeded, context );
 
 #if OSL_USE_BATCHED
-	if( batchSize == 1 )
-	{
-		return executeShade( shadeParameters, renderState, shaderGroup, shadingSystem );
-	}
-	else if( batchSize == 8 )
+	if( batchSize > 1 && useBatchedShading && !compiledGroup->batchedShadingFailed )
 	{
-		ShadingSystem::BatchedExecutor<8> executor( *shadingSystem );
-		return executeShadeBatched<8>( shadeParameters, renderState, shaderGroup, executor );
-	}
-	else
-	{
-		ShadingSystem::BatchedExecutor<16> executor( *shadingSystem );
-		return executeShadeBatched<16>( shadeParameters, renderState, shaderGroup, executor );
+		IECore::CompoundDataPtr result;
+		if( batchSize == 8 )
+		{
+			ShadingSystem::BatchedExecutor<8> executor( *shadingSystem );
+			result = executeShadeBatched<8>( shadeParameters, renderState, shaderGroup, executor );
+		}
+		else
+		{
+			ShadingSystem::BatchedExecutor<16> executor( *shadingSystem );
+			result = executeShadeBatched<16>( shadeParameters, renderState, shaderGroup, executor );
+		}
+
+		if( result )
+		{
+			return result;
+		}
+
+		// The network uses features that OSL doesn't support for batched
+		// execution. Remember that, so we don't try again, and fall back
+		// to non-batched shading.
+		if( !compiledGroup->batchedShadingFailed.exchange( true ) )
+		{
+			msg( Msg::Warning, "ShadingEngine", "Unable to compile shader network for batched shading. Falling back to non-batched shading." );
+		}
 	}
-#else
-	return executeShade( shadeParameters, renderState, shaderGroup, shadingSystem );
 #endif
 
+	return executeShade( shadeParameters, renderState, shaderGroup, shadingSystem );
+
 }
 
 bool ShadingEngine::needsAttribute( const std::string &name ) const
@@ -117,7 +117,7 @@ std::string repr( ShadingEngine::Transform &s )
 	);
 }
 
-IECore::CompoundDataPtr shadeWrapper( ShadingEngine &shadingEngine, const IECore::CompoundData *points, boost::python::dict pythonTransforms, boost::python::dict pythonPointClouds )
+IECore::CompoundDataPtr shadeWrapper( ShadingEngine &shadingEngine, const IECore::CompoundData *points, boost::python::dict pythonTransforms, boost::python::dict pythonPointClouds, boost::python::dict pythonIndices, bool useBatchedShading )
 {
 	ShadingEngine::Transforms transforms;
 
@@ -173,7 +173,34 @@ IECore::CompoundDataPtr shadeWrapper( ShadingEngine &shadingEngine, const IECore
 		pointClouds[keyElem()] = valueElem();
 	}
 
-	return shadingEngine.shade( points, transforms, pointClouds );
+	ShadingEngine::Indices indices;
+
+	values = pythonIndices.values();
+	keys = pythonIndices.keys();
+
+	for( int i = 0; i < boost::python::len( keys ); i++ )
+	{
+		object key( keys[i] );
+		object value( values[i] );
+
+		extract<const char *> keyElem( key );
+		if( !keyElem.check() )
+		{
+			PyErr_SetString( PyExc_TypeError, "Expected string" );
+			throw_error_already_set();
+		}
+
+		extract<IECore::ConstIntVectorDataPtr> valueElem( value );
+		if( !valueElem.check() )
+		{
+			PyErr_SetString( PyExc_TypeError, "Expected IECore.IntVectorData." );
+			throw_error_already_set();
+		}
+
+		indices[keyElem()] = valueElem();
+	}
+
+	return shadingEngine.shade( points, transforms, pointClouds, indices, useBatchedShading );
 }
 
 IECore::CompoundDataPtr shadeUVTextureWrapper( const IECoreScene::ShaderNetwork &shaderNetwork, const Imath::V2i &resolution, const IECoreScene::ShaderNetwork::Parameter &output )
@@ -233,7 +260,9 @@ BOOST_PYTHON_MODULE( _GafferOSL )
 				(
 					boost::python::arg( "points" ),
 					boost::python::arg( "transforms" ) = boost::python::dict(),
-					boost::python::arg( "pointClouds" ) = boost::python::dict()
+					boost::python::arg( "pointClouds" ) = boost::python::dict(),
+					boost::python::arg( "indices" ) = boost::python::dict(),
+					boost::python::arg( "useBatchedShading" ) = true
 				)
 			)
 			.def( "needsAttribute", &ShadingEngine::needsAttribute )
@@ -38,49 +38,29 @@
 
 #include "IECore/StringAlgo.h"
 
+#include "boost/functional/hash.hpp"
 #include "boost/lexical_cast.hpp"
 #include "boost/regex.hpp"
 
 #include "fmt/format.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 using namespace std;
 using namespace IECore;
 
-namespace IECore
-{
-
-/// \todo Move to Cortex. This `hash_value()` implementation differs from the existing
-/// `std::hash` implementation that Cortex has in that it hashes the pointer and not
-/// the string contents. I don't see any reason not to make `std::hash` use the faster
-/// option as well.
-/// Override `boost::hash_value()` to allow InternedString to be used
-/// with `hashed_index`.
-size_t hash_value( const IECore::InternedString &v )
-{
-	return boost::hash<const char *>()( v.c_str() );
-}
-
-} // namespace IECore
-
 namespace GafferScene
 {
 
 namespace Private
 {
 
-// Override `boost::hash_value()` to allow Input to be used
-/// with `hashed_index`.
-size_t hash_value( const ChildNamesMap::Input &v )
+namespace
 {
-	size_t s = 0;
-	boost::hash_combine( s, v.name );
-	boost::hash_combine( s, v.index );
-	return s;
-}
 
-InternedString ChildNamesMap::uniqueName( InternedString name, const std::unordered_set<InternedString> &existingNames )
+template<typename Container>
+InternedString uniqueNameInternal( InternedString name, const Container &existingNames )
 {
 	if( existingNames.find( name ) != existingNames.end() )
 	{
@@ -97,25 +77,100 @@ InternedString ChildNamesMap::uniqueName( InternedString name, const std::unorde
 	return name;
 }
 
+} // namespace
+
+size_t ChildNamesMap::InternedStringHash::operator()( const IECore::InternedString &name ) const
+{
+	// Hash the pointer rather than the string contents, since it is much
+	// quicker and InternedStrings are unique.
+	return std::hash<const char *>()( name.c_str() );
+}
+
+size_t ChildNamesMap::InputHash::operator()( const Input &input ) const
+{
+	size_t s = 0;
+	boost::hash_combine( s, input.name.c_str() );
+	boost::hash_combine( s, input.index );
+	return s;
+}
+
+InternedString ChildNamesMap::uniqueName( InternedString name, const std::unordered_set<InternedString> &existingNames )
+{
+	return uniqueNameInternal( name, existingNames );
+}
+
 ChildNamesMap::ChildNamesMap( const std::vector<IECore::ConstInternedStringVectorDataPtr> &inputChildNames )
-	:	m_childNames( new InternedStringVectorData() )
+	:	m_inputChildNames( inputChildNames )
 {
-	vector<InternedString> &outputChildNames = m_childNames->writable();
+	m_inputOffsets.reserve( inputChildNames.size() );
+
+	size_t numChildren = 0;
+	const InternedStringVectorData *soleNonEmptyInput = nullptr;
+	size_t numNonEmptyInputs = 0;
+	for( const auto &childNamesData : inputChildNames )
+	{
+		m_inputOffsets.push_back( numChildren );
+		const size_t size = childNamesData->readable().size();
+		numChildren += size;
+		if( size )
+		{
+			soleNonEmptyInput = childNamesData.get();
+			numNonEmptyInputs++;
+		}
+	}
+
+	m_outputIndices.reserve( numChildren );
 
-	unordered_set<InternedString> allNames;
+	InternedStringVectorDataPtr outputChildNamesData;
+	if( numNonEmptyInputs != 1 )
+	{
+		outputChildNamesData = new InternedStringVectorData;
+		outputChildNamesData->writable().reserve( numChildren );
+	}
+
+	size_t outputIndex = 0;
 	size_t index = 0;
 	for( const auto &childNamesData : inputChildNames )
 	{
 		for( const auto &inputChildName : childNamesData->readable() )
 		{
-			const InternedString outputChildName = uniqueName( inputChildName, allNames );
-			allNames.insert( outputChildName );
-			outputChildNames.push_back( outputChildName );
+			InternedString outputChildName = inputChildName;
+			if( !m_outputIndices.try_emplace( inputChildName, outputIndex ).second )
+			{
+				outputChildName = uniqueNameInternal( inputChildName, m_outputIndices );
+				m_outputIndices.try_emplace( outputChildName, outputIndex );
+				m_renamed.try_emplace( Input{ inputChildName, index }, outputChildName );
+				if( !outputChildNamesData )
+				{
+					// We were hoping to share the input data, but now need
+					// a copy so we can rename.
+					outputChildNamesData = new InternedStringVectorData;
+					outputChildNamesData->writable().reserve( numChildren );
+					const vector<InternedString> &input = soleNonEmptyInput->readable();
+					outputChildNamesData->writable().insert(
+						outputChildNamesData->writable().end(),
+						input.begin(), input.begin() + ( outputIndex - m_inputOffsets[index] )
+					);
+				}
+			}
 
-			m_map.insert( { { inputChildName, index }, outputChildName } );
+			if( outputChildNamesData )
+			{
+				outputChildNamesData->writable().push_back( outputChildName );
+			}
+			outputIndex++;
 		}
 		index++;
 	}
+
+	if( outputChildNamesData )
+	{
+		m_childNames = outputChildNamesData;
+	}
+	else
+	{
+		m_childNames = soleNonEmptyInput;
+	}
 }
 
 const IECore::InternedStringVectorData *ChildNamesMap::outputChildNames() const
@@ -123,17 +178,68 @@ const IECore::InternedStringVectorData *ChildNamesMap::outputChildNames() const
 	return m_childNames.get();
 }
 
-const ChildNamesMap::Input &ChildNamesMap::input( IECore::InternedString outputName ) const
+ChildNamesMap::Input ChildNamesMap::input( IECore::InternedString outputName ) const
 {
-	auto it = m_map.find( outputName );
-	if( it == m_map.end() )
+	auto it = m_outputIndices.find( outputName );
+	if( it == m_outputIndices.end() )
 	{
 		throw IECore::Exception(
 			fmt::format( "Invalid child name \"{}\"", outputName.string() )
 		);
 	}
 
-	return it->input;
+	const size_t index = inputIndex( it->second );
+	return { m_inputChildNames[index]->readable()[it->second - m_inputOffsets[index]], index };
+}
+
+size_t ChildNamesMap::inputIndex( size_t outputIndex ) const
+{
+	// Find the last input starting at or before `outputIndex`. Empty inputs
+	// share their offset with the next input, so `upper_bound()` skips them.
+	auto it = std::upper_bound( m_inputOffsets.begin(), m_inputOffsets.end(), outputIndex );
+	return ( it - m_inputOffsets.begin() ) - 1;
+}
+
+bool ChildNamesMap::isUnrenamedChild( IECore::InternedString inputName, size_t inputIndex ) const
+{
+	if( inputIndex >= m_inputChildNames.size() )
+	{
+		return false;
+	}
+
+	auto it = m_outputIndices.find( inputName );
+	if( it == m_outputIndices.end() )
+	{
+		return false;
+	}
+
+	// The output name may have been claimed by a renamed child, so check
+	// that it really originates from the input in question.
+	const size_t offset = m_inputOffsets[inputIndex];
+	const vector<InternedString> &names = m_inputChildNames[inputIndex]->readable();
+	return
+		it->second >= offset && it->second < offset + names.size() &&
+		names[it->second - offset] == inputName
+	;
+}
+
+void ChildNamesMap::memoryUsage( IECore::Object::MemoryAccumulator &accumulator ) const
+{
+	Data::memoryUsage( accumulator );
+	accumulator.accumulate( m_childNames.get() );
+	for( const auto &i : m_inputChildNames )
+	{
+		accumulator.accumulate( i.get() );
+	}
+	accumulator.accumulate( m_inputOffsets.capacity() * sizeof( size_t ) );
+	accumulator.accumulate(
+		m_outputIndices.size() * ( sizeof( InternedString ) + sizeof( size_t ) + sizeof( void * ) ) +
+		m_outputIndices.bucket_count() * sizeof( void * )
+	);
+	accumulator.accumulate(
+		m_renamed.size() * ( sizeof( Input ) + sizeof( InternedString ) + sizeof( void * ) ) +
+		m_renamed.bucket_count() * sizeof( void * )
+	);
 }
 
 IECore::PathMatcher ChildNamesMap::set( const std::vector<IECore::ConstPathMatcherDataPtr> &inputSets ) const
@@ -159,11 +265,14 @@ IECore::PathMatcher ChildNamesMap::set( const std::vector<IECore::ConstPathMatch
 				}
 				assert( inputPath.size() == 1 );
 
-				const auto &inputMap = m_map.get<1>();
-				auto it = inputMap.find( Input{ inputPath[0], inputIndex } );
-				if( it != inputMap.end() )
+				auto it = m_renamed.find( Input{ inputPath[0], inputIndex } );
+				if( it != m_renamed.end() )
+				{
+					result.addPaths( inputSet.subTree( inputPath ), { it->second } );
+				}
+				else if( isUnrenamedChild( inputPath[0], inputIndex ) )
 				{
-					result.addPaths( inputSet.subTree( inputPath ), { it->output } );
+					result.addPaths( inputSet.subTree( inputPath ), { inputPath[0] } );
 				}
 				else
 				{
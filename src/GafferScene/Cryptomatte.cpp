@@ -39,8 +39,10 @@
 #include "GafferImage/ImageAlgo.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "IECore/MessageHandler.h"
+#include "IECore/NullObject.h"
 
 #include <boost/iostreams/stream.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -50,7 +52,10 @@
 #include "fmt/format.h"
 
 #include <filesystem>
+#include <functional>
+#include <limits>
 #include <regex>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -192,30 +197,221 @@ IECore::CompoundDataPtr propertyTreeToCompoundData( const boost::property_tree::
 	return resultData;
 }
 
-IECore::CompoundDataPtr parseManifestFromMetadata( const std::string &metadataKey, ConstCompoundDataPtr metadata )
+// Path in the form used as a key by ManifestIndex. This matches the
+// tokenisation performed by `PathMatcher::addPath()`, ignoring empty
+// path components.
+std::string indexKey( const std::string &name )
 {
-	if( metadata->readable().find( metadataKey ) == metadata->readable().end() )
+	std::string result;
+	result.reserve( name.size() + 1 );
+	size_t begin = 0;
+	while( begin < name.size() )
 	{
-		throw IECore::Exception( fmt::format( "Image metadata entry not found: {}", metadataKey ) );
+		size_t end = name.find( '/', begin );
+		if( end == std::string::npos )
+		{
+			end = name.size();
+		}
+		if( end > begin )
+		{
+			result += '/';
+			result.append( name, begin, end - begin );
+		}
+		begin = end + 1;
 	}
+	return result;
+}
 
-	const StringData *manifest = metadata->member<StringData>( metadataKey );
-	boost::iostreams::stream<boost::iostreams::array_source> stream( manifest->readable().c_str(), manifest->readable().size() );
-	boost::property_tree::ptree pt;
+// Holds a parsed manifest along with an index of its entries sorted
+// by path, so that the values for a path and all its descendants can
+// be found with a binary search rather than a scan of the whole manifest.
+class ManifestIndex : public Data
+{
+
+	public :
+
+		ManifestIndex( const ConstCompoundDataPtr &manifest )
+			:	m_manifest( manifest )
+		{
+			m_entries.reserve( manifest->readable().size() );
+			for( const auto &manifestEntry : manifest->readable() )
+			{
+				const std::string &matteName = static_cast<const IECore::StringData *>( manifestEntry.second.get() )->readable();
+				const std::string key = indexKey( matteName );
+				m_entries.push_back( { m_keys.size(), key.size(), matteNameToValue( matteName ) } );
+				m_keys += key;
+			}
+			m_keys.shrink_to_fit();
+
+			std::sort(
+				m_entries.begin(), m_entries.end(),
+				[this] ( const Entry &a, const Entry &b ) {
+					return key( a ) < key( b );
+				}
+			);
+		}
+
+		const CompoundData *manifest() const
+		{
+			return m_manifest.get();
+		}
+
+		// Inserts the values for all entries matched by `path`, either
+		// exactly or as descendants. Equivalent to testing each entry for an
+		// `ExactMatch` or `AncestorMatch` using a PathMatcher containing `path`,
+		// which must not contain wildcards.
+		void matchingValues( const std::string &path, std::unordered_set<float> &values ) const
+		{
+			const std::string pathKey = indexKey( path );
+			if( pathKey.empty() )
+			{
+				// Root matches everything.
+				for( const auto &entry : m_entries )
+				{
+					values.insert( entry.value );
+				}
+				return;
+			}
+
+			insertValues( pathKey, /* prefix = */ false, values );
+			insertValues( pathKey + "/", /* prefix = */ true, values );
+		}
+
+		void copyFrom( const Object *other, CopyContext *context ) override
+		{
+			Data::copyFrom( other, context );
+			msg( Msg::Warning, "ManifestIndex::copyFrom", "Not implemented" );
+		}
+
+		void save( SaveContext *context ) const override
+		{
+			Data::save( context );
+			msg( Msg::Warning, "ManifestIndex::save", "Not implemented" );
+		}
+
+		void load( LoadContextPtr context ) override
+		{
+			Data::load( context );
+			msg( Msg::Warning, "ManifestIndex::load", "Not implemented" );
+		}
+
+		void memoryUsage( Object::MemoryAccumulator &accumulator ) const override
+		{
+			Data::memoryUsage( accumulator );
+			accumulator.accumulate( m_manifest.get() );
+			accumulator.accumulate( m_keys.capacity() + m_entries.capacity() * sizeof( Entry ) );
+		}
+
+	private :
+
+		struct Entry
+		{
+			size_t offset;
+			size_t size;
+			float value;
+		};
+
+		std::string_view key( const Entry &entry ) const
+		{
+			return std::string_view( m_keys.data() + entry.offset, entry.size );
+		}
+
+		void insertValues( const std::string &searchKey, bool prefix, std::unordered_set<float> &values ) const
+		{
+			const std::string_view searchView( searchKey );
+			auto it = std::lower_bound(
+				m_entries.begin(), m_entries.end(), searchView,
+				[this] ( const Entry &entry, std::string_view k ) {
+					return key( entry ) < k;
+				}
+			);
+
+			for( ; it != m_entries.end(); ++it )
+			{
+				const std::string_view entryKey = key( *it );
+				if( prefix ? entryKey.substr( 0, searchView.size() ) != searchView : entryKey != searchView )
+				{
+					break;
+				}
+				values.insert( it->value );
+			}
+		}
+
+		ConstCompoundDataPtr m_manifest;
+		// Storage for the keys of all entries, concatenated.
+		std::string m_keys;
+		std::vector<Entry> m_entries;
+
+};
+
+IE_CORE_DECLAREPTR( ManifestIndex )
+
+// Manifests are cached based on their content rather than the plug values
+// used to locate them, so that they are parsed and indexed only once, even
+// when the image metadata varies from frame to frame.
+
+using ManifestParser = std::function<CompoundDataPtr ()>;
+
+struct ManifestCacheGetterKey
+{
 
-	try
+	ManifestCacheGetterKey( const IECore::MurmurHash &hash, const ManifestParser &parser )
+		:	hash( hash ), parser( parser )
 	{
-		boost::property_tree::read_json( stream, pt );
 	}
-	catch( const boost::property_tree::json_parser::json_parser_error &e )
+
+	operator const IECore::MurmurHash & () const
 	{
-		throw IECore::Exception( fmt::format( "Error parsing manifest metadata: {}", e.what() ) );
+		return hash;
 	}
 
-	return propertyTreeToCompoundData( pt );
+	const IECore::MurmurHash hash;
+	const ManifestParser &parser;
+
+};
+
+ConstManifestIndexPtr manifestCacheGetter( const ManifestCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	ConstManifestIndexPtr result = new ManifestIndex( key.parser() );
+	cost = result->Object::memoryUsage();
+	return result;
 }
 
-IECore::CompoundDataPtr parseManifestFromSidecarFile( const std::string &manifestFile )
+using ManifestCache = IECorePreview::LRUCache<IECore::MurmurHash, ConstManifestIndexPtr, IECorePreview::LRUCachePolicy::TaskParallel, ManifestCacheGetterKey>;
+ManifestCache g_manifestCache( manifestCacheGetter, 512 * 1024 * 1024 );
+
+ConstManifestIndexPtr parseManifestFromMetadata( const std::string &metadataKey, ConstCompoundDataPtr metadata )
+{
+	if( metadata->readable().find( metadataKey ) == metadata->readable().end() )
+	{
+		throw IECore::Exception( fmt::format( "Image metadata entry not found: {}", metadataKey ) );
+	}
+
+	const StringData *manifest = metadata->member<StringData>( metadataKey );
+
+	const ManifestParser parser = [manifest] () {
+		boost::iostreams::stream<boost::iostreams::array_source> stream( manifest->readable().c_str(), manifest->readable().size() );
+		boost::property_tree::ptree pt;
+
+		try
+		{
+			boost::property_tree::read_json( stream, pt );
+		}
+		catch( const boost::property_tree::json_parser::json_parser_error &e )
+		{
+			throw IECore::Exception( fmt::format( "Error parsing manifest metadata: {}", e.what() ) );
+		}
+
+		return propertyTreeToCompoundData( pt );
+	};
+
+	IECore::MurmurHash h;
+	h.append( "metadata" );
+	h.append( manifest->readable() );
+	return g_manifestCache.get( ManifestCacheGetterKey( h, parser ) );
+}
+
+ConstManifestIndexPtr parseManifestFromSidecarFile( const std::string &manifestFile )
 {
 	if( manifestFile == "" )
 	{
@@ -226,21 +422,40 @@ IECore::CompoundDataPtr parseManifestFromSidecarFile( const std::string &manifes
 		throw IECore::Exception( fmt::format( "Manifest file not found: {}", manifestFile ) );
 	}
 
-	boost::property_tree::ptree pt;
+	const ManifestParser parser = [&manifestFile] () {
+		boost::property_tree::ptree pt;
 
-	try
-	{
-		boost::property_tree::read_json( manifestFile, pt );
-	}
-	catch( const boost::property_tree::json_parser::json_parser_error &e )
+		try
+		{
+			boost::property_tree::read_json( manifestFile, pt );
+		}
+		catch( const boost::property_tree::json_parser::json_parser_error &e )
+		{
+			throw IECore::Exception( fmt::format( "Error parsing manifest file: {}", e.what() ) );
+		}
+
+		return propertyTreeToCompoundData( pt );
+	};
+
+	// Include the modification time and size in the cache key, so that
+	// we reload the manifest if the file is rewritten.
+	std::error_code errorCode;
+	const auto writeTime = std::filesystem::last_write_time( manifestFile, errorCode );
+	const auto fileSize = errorCode ? 0 : std::filesystem::file_size( manifestFile, errorCode );
+	if( errorCode )
 	{
-		throw IECore::Exception( fmt::format( "Error parsing manifest file: {}", e.what() ) );
+		return new ManifestIndex( parser() );
 	}
 
-	return propertyTreeToCompoundData( pt );
+	IECore::MurmurHash h;
+	h.append( "file" );
+	h.append( manifestFile );
+	h.append( (uint64_t)writeTime.time_since_epoch().count() );
+	h.append( (uint64_t)fileSize );
+	return g_manifestCache.get( ManifestCacheGetterKey( h, parser ) );
 }
 
-IECore::CompoundDataPtr parseManifestFromMetadataAndSidecar( const std::string &metadataKey, ConstCompoundDataPtr metadata, std::string manifestDirectory )
+ConstManifestIndexPtr parseManifestFromMetadataAndSidecar( const std::string &metadataKey, ConstCompoundDataPtr metadata, std::string manifestDirectory )
 {
 	if( metadata->readable().find( metadataKey ) == metadata->readable().end() )
 	{
@@ -272,7 +487,7 @@ IECore::CompoundDataPtr parseManifestFromMetadataAndSidecar( const std::string &
 
 const std::regex g_nameMetadataRegex( R"((cryptomatte/[^/]{1,7})/name)" );
 
-IECore::CompoundDataPtr parseManifestFromFirstMetadataEntry( const std::string &cryptomatteLayer, ConstCompoundDataPtr metadata, const std::string &manifestDirectory )
+ConstManifestIndexPtr parseManifestFromFirstMetadataEntry( const std::string &cryptomatteLayer, ConstCompoundDataPtr metadata, const std::string &manifestDirectory )
 {
 	// The Cryptomatte specification suggests metadata entries stored for each
 	// layer based on a key generated from the first 7 characters of the hashed
@@ -380,6 +595,7 @@ Cryptomatte::Cryptomatte( const std::string &name )
 	addChild( new PathMatcherDataPlug( "__manifestPaths", Gaffer::Plug::Out, new PathMatcherData ) );
 	addChild( new ScenePlug( "manifestScene", Gaffer::Plug::Out ) );
 	addChild( new FloatVectorDataPlug( "__matteChannelData", Gaffer::Plug::Out, GafferImage::ImagePlug::blackTile() ) );
+	addChild( new ObjectPlug( "__manifestIndex", Gaffer::Plug::Out, NullObject::defaultNullObject() ) );
 
 	outPlug()->formatPlug()->setInput( inPlug()->formatPlug() );
 	outPlug()->metadataPlug()->setInput( inPlug()->metadataPlug() );
@@ -500,6 +716,16 @@ const Gaffer::FloatVectorDataPlug *Cryptomatte::matteChannelDataPlug() const
 	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 10 );
 }
 
+Gaffer::ObjectPlug *Cryptomatte::manifestIndexPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 11 );
+}
+
+const Gaffer::ObjectPlug *Cryptomatte::manifestIndexPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 11 );
+}
+
 void Cryptomatte::affects(const Gaffer::Plug *input, AffectedPlugsContainer &outputs) const
 {
 	FlatImageProcessor::affects(input, outputs);
@@ -528,12 +754,17 @@ void Cryptomatte::affects(const Gaffer::Plug *input, AffectedPlugsContainer &out
 		input == sidecarFilePlug() ||
 		input == manifestSourcePlug() ||
 		input == inPlug()->metadataPlug() )
+	{
+		outputs.push_back( manifestIndexPlug() );
+	}
+
+	if( input == manifestIndexPlug() )
 	{
 		outputs.push_back( manifestPlug() );
 	}
 
 	if( input == matteNamesPlug() ||
-		input == manifestPlug() )
+		input == manifestIndexPlug() )
 	{
 		outputs.push_back( matteValuesPlug() );
 	}
@@ -553,7 +784,7 @@ void Cryptomatte::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *
 {
 	FlatImageProcessor::hash( output, context, h );
 
-	if( output == manifestPlug() )
+	if( output == manifestIndexPlug() )
 	{
 		manifestSourcePlug()->hash( h );
 		switch( (ManifestSource)manifestSourcePlug()->getValue() )
@@ -579,9 +810,13 @@ void Cryptomatte::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *
 			}
 		}
 	}
+	else if( output == manifestPlug() )
+	{
+		manifestIndexPlug()->hash( h );
+	}
 	else if( output == matteValuesPlug() )
 	{
-		manifestPlug()->hash( h );
+		manifestIndexPlug()->hash( h );
 		matteNamesPlug()->hash( h );
 	}
 	else if( output == manifestPathDataPlug() )
@@ -639,9 +874,9 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 {
 	FlatImageProcessor::compute( output, context );
 
-	if( output == manifestPlug() )
+	if( output == manifestIndexPlug() )
 	{
-		IECore::CompoundDataPtr resultData = nullptr;
+		ConstManifestIndexPtr resultData = nullptr;
 
 		switch( (ManifestSource)manifestSourcePlug()->getValue() )
 		{
@@ -671,7 +906,21 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 
 		if( resultData )
 		{
-			static_cast<AtomicCompoundDataPlug *>( output )->setValue( resultData );
+			static_cast<ObjectPlug *>( output )->setValue( resultData );
+		}
+		else
+		{
+			static_cast<ObjectPlug *>( output )->setToDefault();
+		}
+	}
+	else if( output == manifestPlug() )
+	{
+		ConstObjectPtr manifestIndex = manifestIndexPlug()->getValue();
+		if( manifestIndex->typeId() != NullObjectTypeId )
+		{
+			static_cast<AtomicCompoundDataPlug *>( output )->setValue(
+				static_cast<const ManifestIndex *>( manifestIndex.get() )->manifest()
+			);
 		}
 		else
 		{
@@ -685,9 +934,12 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 		std::unordered_set<float> matteValues;
 
 		ConstStringVectorDataPtr matteNames = matteNamesPlug()->getValue();
-		ConstCompoundDataPtr manifest = manifestPlug()->getValue();
+		ConstObjectPtr manifestIndexObject = manifestIndexPlug()->getValue();
+		const ManifestIndex *manifestIndex = manifestIndexObject->typeId() != NullObjectTypeId ? static_cast<const ManifestIndex *>( manifestIndexObject.get() ) : nullptr;
 
-		IECore::PathMatcher pathMatcher;
+		// Names containing wildcards must be matched against every entry
+		// in the manifest, but all others can use the index.
+		IECore::PathMatcher wildcardPathMatcher;
 		for( const auto &name : matteNames->readable() )
 		{
 			if( name.size() > 0 && name.front() == '<' && name.back() == '>' )
@@ -704,9 +956,17 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 			}
 			else
 			{
-				if( manifest )
+				const bool hasWildcards = StringAlgo::hasWildcards( name ) || name.find( "..." ) != string::npos;
+				if( manifestIndex )
 				{
-					pathMatcher.addPath( name );
+					if( hasWildcards )
+					{
+						wildcardPathMatcher.addPath( name );
+					}
+					else
+					{
+						manifestIndex->matchingValues( name, matteValues );
+					}
 				}
 
 				if( !StringAlgo::hasWildcards( name ) || name.find( "..." ) == string::npos )
@@ -717,12 +977,12 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 			}
 		}
 
-		if( manifest )
+		if( manifestIndex && !wildcardPathMatcher.isEmpty() )
 		{
-			for( const auto &manifestEntry : manifest->readable() )
+			for( const auto &manifestEntry : manifestIndex->manifest()->readable() )
 			{
 				const std::string &matteName = static_cast<IECore::StringData *>( manifestEntry.second.get() )->readable();
-				if( pathMatcher.match( matteName ) & ( IECore::PathMatcher::ExactMatch | IECore::PathMatcher::AncestorMatch ) )
+				if( wildcardPathMatcher.match( matteName ) & ( IECore::PathMatcher::ExactMatch | IECore::PathMatcher::AncestorMatch ) )
 				{
 					matteValues.insert( matteNameToValue( matteName ) );
 				}
@@ -812,6 +1072,11 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 
 		const std::vector<std::string> &channelNames = channelNamesData->readable();
 		const std::vector<float> &matteValues = matteValuesData->readable();
+		if( matteValues.empty() )
+		{
+			static_cast<FloatVectorDataPlug *>( output )->setValue( resultData );
+			return;
+		}
 
 		boost::regex channelNameRegex( fmt::format( g_cryptomatteChannelPattern, cryptomatteLayer ) );
 		GafferImage::ImagePlug::ChannelDataScope channelDataScope( context );
@@ -839,11 +1104,26 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 				ConstFloatVectorDataPtr alphaData = inPlug()->channelDataPlug()->getValue();
 				const std::vector<float> &alpha = alphaData->readable();
 
+				// Neighbouring pixels usually share the same ID, so we reuse
+				// the result of the previous search where we can. Pixels
+				// with no coverage don't need searching at all.
+				float lastValue = std::numeric_limits<float>::quiet_NaN();
+				bool lastMatched = false;
+
 				std::vector<float>::const_iterator vIt = value.begin();
 				std::vector<float>::const_iterator aIt = alpha.begin();
 				for( std::vector<float>::iterator it = result.begin(), eIt = result.end(); it != eIt; ++it, ++vIt, ++aIt )
 				{
-					if( std::binary_search( matteValues.begin(), matteValues.end(), *vIt ) )
+					if( *aIt == 0.0f )
+					{
+						continue;
+					}
+					if( *vIt != lastValue )
+					{
+						lastValue = *vIt;
+						lastMatched = std::binary_search( matteValues.begin(), matteValues.end(), *vIt );
+					}
+					if( lastMatched )
 					{
 						*it += *aIt;
 					}
@@ -858,6 +1138,7 @@ void Cryptomatte::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 Gaffer::ValuePlug::CachePolicy Cryptomatte::computeCachePolicy( const Gaffer::ValuePlug *output ) const
 {
 	if( output == matteValuesPlug() ||
+		output == manifestIndexPlug() ||
 		output == manifestPlug() ||
 		output == manifestPathDataPlug() )
 	{
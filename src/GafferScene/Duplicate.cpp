@@ -43,7 +43,9 @@
 #include "IECore/NullObject.h"
 #include "IECore/StringAlgo.h"
 
-#include <unordered_map>
+#include "fmt/format.h"
+
+#include <cctype>
 
 using namespace std;
 using namespace IECore;
@@ -85,29 +87,37 @@ class Duplicate::DuplicatesData : public IECore::Data
 				suffix++;
 			}
 
-			// Generate names, and at the same time, the transforms associated with them.
+			// Generate names. Rather than store a transform for every copy,
+			// we store only every `g_checkpointInterval`th transform, and
+			// compute the others on demand. This keeps memory usage low for
+			// large numbers of copies.
+
+			m_stem = stem;
+			m_firstSuffix = suffix;
+			m_matrix = node->transformPlug()->matrix();
 
 			m_names = new InternedStringVectorData;
 			std::vector<InternedString> &names = m_names->writable();
 			names.reserve( copies );
 
-			const Imath::M44f matrix = node->transformPlug()->matrix();
-
 			if( suffix == -1 )
 			{
 				assert( copies == 1 );
 				names.push_back( stem );
-				m_transforms[stem] = matrix;
+				m_checkpoints.push_back( m_matrix );
 			}
 			else
 			{
-				Imath::M44f m = matrix;
+				m_checkpoints.reserve( copies / g_checkpointInterval + 1 );
+				Imath::M44f m = m_matrix;
 				for( int i = 0; i < copies; ++i )
 				{
-					InternedString name = stem + std::to_string( suffix++ );
-					names.push_back( name );
-					m_transforms[name] = m;
-					m = m * matrix;
+					names.push_back( stem + std::to_string( suffix++ ) );
+					if( i % g_checkpointInterval == 0 )
+					{
+						m_checkpoints.push_back( m );
+					}
+					m = m * m_matrix;
 				}
 			}
 		}
@@ -142,15 +152,81 @@ class Duplicate::DuplicatesData : public IECore::Data
 			return m_names;
 		}
 
-		const Imath::M44f &transform( const IECore::InternedString &name ) const
+		Imath::M44f transform( const IECore::InternedString &name ) const
+		{
+			// Accumulate from the nearest checkpoint, performing exactly
+			// the same sequence of multiplications as the constructor.
+			const size_t i = index( name );
+			const size_t checkpoint = i / g_checkpointInterval;
+			Imath::M44f result = m_checkpoints[checkpoint];
+			for( size_t j = checkpoint * g_checkpointInterval; j < i; ++j )
+			{
+				result = result * m_matrix;
+			}
+			return result;
+		}
+
+		void memoryUsage( Object::MemoryAccumulator &accumulator ) const override
 		{
-			return m_transforms.at( name );
+			Data::memoryUsage( accumulator );
+			accumulator.accumulate( m_names.get() );
+			accumulator.accumulate( m_checkpoints.capacity() * sizeof( Imath::M44f ) );
 		}
 
 	private :
 
+		// Lookups cost at most `g_checkpointInterval - 1` matrix multiplications,
+		// and are made for every copy when computing bounds, so we keep the
+		// interval small. Checkpoints still take only an eighth of the memory
+		// of storing every transform.
+		static const size_t g_checkpointInterval = 8;
+
+		// Equivalent to `StringAlgo::numericSuffix()`, but avoiding the
+		// allocation of a string for the stem, since this is called for
+		// every transform lookup.
+		size_t index( const IECore::InternedString &name ) const
+		{
+			size_t result = 0;
+			if( m_firstSuffix != -1 )
+			{
+				const std::string &s = name.string();
+				size_t suffixBegin = s.size();
+				while( suffixBegin > 0 && s.size() - suffixBegin < 18 && std::isdigit( (unsigned char)s[suffixBegin-1] ) )
+				{
+					suffixBegin--;
+				}
+
+				size_t suffix = 0;
+				for( size_t i = suffixBegin; i < s.size(); ++i )
+				{
+					suffix = suffix * 10 + ( s[i] - '0' );
+				}
+
+				if(
+					suffixBegin == s.size() || suffixBegin != m_stem.size() ||
+					suffix < (size_t)m_firstSuffix || s.compare( 0, suffixBegin, m_stem ) != 0
+				)
+				{
+					result = m_names->readable().size();
+				}
+				else
+				{
+					result = suffix - m_firstSuffix;
+				}
+			}
+
+			if( result >= m_names->readable().size() || m_names->readable()[result] != name )
+			{
+				throw IECore::Exception( fmt::format( "Duplicate \"{}\" not found", name.string() ) );
+			}
+			return result;
+		}
+
+		std::string m_stem;
+		int m_firstSuffix;
+		Imath::M44f m_matrix;
 		InternedStringVectorDataPtr m_names;
-		unordered_map<InternedString, Imath::M44f> m_transforms;
+		std::vector<Imath::M44f> m_checkpoints;
 
 };
 
@@ -73,11 +73,14 @@
 
 #include "boost/algorithm/string/predicate.hpp"
 
+#include "tbb/blocked_range.h"
 #include "tbb/concurrent_queue.h"
+#include "tbb/parallel_for.h"
 
 #include "fmt/format.h"
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -529,8 +532,7 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 		void transform( const Imath::M44f &transform ) override
 		{
 			m_editQueue.push( [this, transform]() {
-				m_transform = transform;
-				m_transformSansScale = sansScalingAndShear( transform, false );
+				setTransform( transform );
 			} );
 		}
 
@@ -686,6 +688,14 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			}
 		}
 
+		// Assigns the transform immediately rather than via the edit queue.
+		// This is only safe before the object has been added to the renderer.
+		void setTransform( const Imath::M44f &transform )
+		{
+			m_transform = transform;
+			m_transformSansScale = sansScalingAndShear( transform, false );
+		}
+
 		IECore::TypeId objectType() const
 		{
 			return m_objectType;
@@ -1000,6 +1010,59 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			return object( name, samples.front(), attributes );
 		}
 
+		void objects( const std::vector<ObjectDescription> &objects, std::vector<ObjectInterfacePtr> &result ) override
+		{
+			result.assign( objects.size(), nullptr );
+
+			// Converting objects is the expensive part, so we do that in parallel.
+			// We ignore links and IDs, which aren't supported by this renderer.
+
+			auto newObjects = std::make_shared<OpenGLObjectVector>( objects.size() );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, objects.size() ),
+				[&]( const tbb::blocked_range<size_t> &range ) {
+					IECore::MessageHandler::Scope s( m_messageHandler.get() );
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						const ObjectDescription &description = objects[i];
+						if( description.samples.empty() )
+						{
+							continue;
+						}
+
+						const IECore::Object *object = description.samples.front();
+						if( !m_renderObjects && !runTimeCast<const IECoreScenePreview::Placeholder>( object ) )
+						{
+							continue;
+						}
+
+						OpenGLObjectPtr openGLObject = new OpenGLObject( description.name, object, static_cast<const OpenGLAttributes *>( description.attributes ), m_editQueue );
+						if( description.transformSamples.size() )
+						{
+							openGLObject->setTransform( description.transformSamples.front() );
+						}
+						(*newObjects)[i] = openGLObject;
+						result[i] = openGLObject;
+					}
+				},
+				taskGroupContext
+			);
+
+			// Add everything to the render with a single edit, rather than
+			// several per object.
+
+			m_editQueue.push( [this, newObjects]() {
+				for( const auto &o : *newObjects )
+				{
+					if( o )
+					{
+						m_objects.push_back( o );
+					}
+				}
+			} );
+		}
+
 		void render() override
 		{
 			IECore::MessageHandler::Scope s( m_messageHandler.get() );
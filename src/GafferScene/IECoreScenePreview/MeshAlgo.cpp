@@ -0,0 +1,377 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
+
+#include "IECore/DataAlgo.h"
+#include "IECore/PolygonAlgo.h"
+#include "IECore/TypeTraits.h"
+
+#include "fmt/format.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScene;
+using namespace IECoreScenePreview;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Number of faces processed by each task. Large enough to amortise the
+// task overhead, small enough for cancellation to be responsive.
+const size_t g_grainSize = 10000;
+
+// Returns the index of the first face-vertex of each face.
+vector<int> faceOffsets( const MeshPrimitive *mesh )
+{
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+
+	vector<int> result;
+	result.reserve( verticesPerFace.size() );
+	int offset = 0;
+	for( int numVertices : verticesPerFace )
+	{
+		result.push_back( offset );
+		offset += numVertices;
+	}
+	return result;
+}
+
+// Calls `f( faceIndex )` for every face of the mesh, in parallel.
+template<typename F>
+void parallelForFaces( const MeshPrimitive *mesh, const Canceller *canceller, F &&f )
+{
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, mesh->numFaces(), g_grainSize ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+template<typename T>
+void reverseFaces( const MeshPrimitive *mesh, const vector<int> &offsets, vector<T> &values, const Canceller *canceller )
+{
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	if constexpr( std::is_same_v<T, bool> )
+	{
+		// Elements of `vector<bool>` share storage, so can't be
+		// written concurrently.
+		for( size_t i = 0; i < verticesPerFace.size(); ++i )
+		{
+			if( i % g_grainSize == 0 )
+			{
+				Canceller::check( canceller );
+			}
+			auto begin = values.begin() + offsets[i];
+			std::reverse( begin, begin + verticesPerFace[i] );
+		}
+	}
+	else
+	{
+		parallelForFaces(
+			mesh, canceller,
+			[&] ( size_t i ) {
+				auto begin = values.begin() + offsets[i];
+				std::reverse( begin, begin + verticesPerFace[i] );
+			}
+		);
+	}
+}
+
+struct MakeWireframe
+{
+
+	CurvesPrimitivePtr operator() ( const V2fVectorData *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const IECore::Canceller *canceller )
+	{
+		return makeWireframe<V2fVectorData>( data, mesh, name, primitiveVariable, canceller );
+	}
+
+	CurvesPrimitivePtr operator() ( const V3fVectorData *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const IECore::Canceller *canceller )
+	{
+		return makeWireframe<V3fVectorData>( data, mesh, name, primitiveVariable, canceller );
+	}
+
+	CurvesPrimitivePtr operator() ( const Data *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const IECore::Canceller *canceller )
+	{
+		throw IECore::Exception(
+			fmt::format( "PrimitiveVariable \"{}\" has unsupported type \"{}\"", name, data->typeName() )
+		);
+	}
+
+	private :
+
+		template<typename T>
+		CurvesPrimitivePtr makeWireframe( const T *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const IECore::Canceller *canceller )
+		{
+			using Vec = typename T::ValueType::value_type;
+			using DataView = PrimitiveVariable::IndexedView<Vec>;
+			DataView dataView;
+			const vector<int> *vertexIds = nullptr;
+			switch( primitiveVariable.interpolation )
+			{
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+					vertexIds = &mesh->vertexIds()->readable();
+					dataView = DataView( primitiveVariable );
+					break;
+				case PrimitiveVariable::FaceVarying :
+					vertexIds = primitiveVariable.indices ? &primitiveVariable.indices->readable() : nullptr;
+					dataView = DataView( data->readable(), nullptr );
+					break;
+				default :
+					throw IECore::Exception(
+						fmt::format( "Primitive variable \"{}\" must have Vertex, Varying or FaceVarying interpolation", name )
+					);
+			}
+
+			// Every face-vertex contributes one edge, and each face writes its
+			// edges into its own range, so the result doesn't depend on
+			// scheduling. Edges shared by several faces are removed below.
+
+			using Edge = std::pair<int, int>;
+			const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+			const vector<int> offsets = faceOffsets( mesh );
+			std::vector<Edge> edges( mesh->variableSize( PrimitiveVariable::FaceVarying ) );
+
+			parallelForFaces(
+				mesh, canceller,
+				[&] ( size_t face ) {
+					const int vertexIdsIndex = offsets[face];
+					const int numVertices = verticesPerFace[face];
+					for( int i = 0; i < numVertices; ++i )
+					{
+						int index0 = vertexIdsIndex + i;
+						int index1 = vertexIdsIndex + (i + 1) % numVertices;
+						if( vertexIds )
+						{
+							index0 = (*vertexIds)[index0];
+							index1 = (*vertexIds)[index1];
+						}
+						edges[vertexIdsIndex+i] = index0 < index1 ? Edge( index0, index1 ) : Edge( index1, index0 );
+					}
+				}
+			);
+
+			// We only want to output each edge once, so sort and discard duplicates.
+			// Duplicate edges are identical, so the instability of the parallel sort
+			// doesn't affect the result.
+			tbb::this_task_arena::isolate(
+				[&] {
+					tbb::parallel_sort( edges.begin(), edges.end() );
+				}
+			);
+			Canceller::check( canceller );
+			edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+			IECore::V3fVectorDataPtr pData = new V3fVectorData;
+			pData->setInterpretation( GeometricData::Point );
+			vector<V3f> &p = pData->writable();
+			// Each edge adds 2 points to `p`.
+			p.resize( edges.size() * 2 );
+
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, edges.size(), g_grainSize ),
+				[&] ( const tbb::blocked_range<size_t> &range ) {
+					Canceller::check( canceller );
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						p[i*2] = v3f( dataView[edges[i].first] );
+						p[i*2+1] = v3f( dataView[edges[i].second] );
+					}
+				},
+				taskGroupContext
+			);
+
+			IECore::IntVectorDataPtr vertsPerCurveData = new IntVectorData;
+			vertsPerCurveData->writable().resize( edges.size(), 2 );
+
+			CurvesPrimitivePtr result = new CurvesPrimitive( vertsPerCurveData );
+			result->variables["P"] = PrimitiveVariable( PrimitiveVariable::Vertex, pData );
+			return result;
+		}
+
+		static V3f v3f( const Imath::V3f &v )
+		{
+			return v;
+		}
+
+		static V3f v3f( const Imath::V2f &v )
+		{
+			return V3f( v.x, v.y, 0.0f );
+		}
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Public API
+//////////////////////////////////////////////////////////////////////////
+
+void MeshAlgo::reverseWinding( MeshPrimitive *mesh, const Canceller *canceller )
+{
+	const vector<int> offsets = faceOffsets( mesh );
+
+	IntVectorDataPtr vertexIdsData = mesh->vertexIds()->copy();
+	reverseFaces( mesh, offsets, vertexIdsData->writable(), canceller );
+
+	// `setTopologyUnchecked()` discards corners and creases, so we must
+	// reapply them. They are specified using vertex ids, so are unaffected
+	// by the change in winding.
+	ConstIntVectorDataPtr cornerIds = mesh->cornerIds();
+	ConstFloatVectorDataPtr cornerSharpnesses = mesh->cornerSharpnesses();
+	ConstIntVectorDataPtr creaseLengths = mesh->creaseLengths();
+	ConstIntVectorDataPtr creaseIds = mesh->creaseIds();
+	ConstFloatVectorDataPtr creaseSharpnesses = mesh->creaseSharpnesses();
+
+	mesh->setTopologyUnchecked(
+		mesh->verticesPerFace(), vertexIdsData.get(),
+		mesh->variableSize( PrimitiveVariable::Vertex ), mesh->interpolation()
+	);
+
+	if( cornerIds->readable().size() )
+	{
+		mesh->setCorners( cornerIds.get(), cornerSharpnesses.get() );
+	}
+	if( creaseLengths->readable().size() )
+	{
+		mesh->setCreases( creaseLengths.get(), creaseIds.get(), creaseSharpnesses.get() );
+	}
+
+	for( auto &[name, primitiveVariable] : mesh->variables )
+	{
+		if( primitiveVariable.interpolation != PrimitiveVariable::FaceVarying )
+		{
+			continue;
+		}
+
+		if( primitiveVariable.indices )
+		{
+			IntVectorDataPtr indices = primitiveVariable.indices->copy();
+			reverseFaces( mesh, offsets, indices->writable(), canceller );
+			primitiveVariable.indices = indices;
+		}
+		else
+		{
+			DataPtr data = primitiveVariable.data->copy();
+			IECore::dispatch(
+				data.get(),
+				[&] ( auto *typedData ) {
+					using DataType = std::remove_pointer_t<decltype( typedData )>;
+					if constexpr( TypeTraits::IsVectorTypedData<DataType>::value )
+					{
+						reverseFaces( mesh, offsets, typedData->writable(), canceller );
+					}
+				}
+			);
+			primitiveVariable.data = data;
+		}
+	}
+}
+
+PrimitiveVariable MeshAlgo::calculateUniformNormals( const MeshPrimitive *mesh, const std::string &position, const Canceller *canceller )
+{
+	const V3fVectorData *pData = mesh->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
+	if( !pData )
+	{
+		throw InvalidArgumentException( fmt::format( "MeshAlgo::calculateUniformNormals : MeshPrimitive has no Vertex \"{}\" primitive variable", position ) );
+	}
+
+	const vector<V3f> &points = pData->readable();
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const vector<int> offsets = faceOffsets( mesh );
+
+	V3fVectorDataPtr normalsData = new V3fVectorData;
+	normalsData->setInterpretation( GeometricData::Normal );
+	vector<V3f> &normals = normalsData->writable();
+	normals.resize( verticesPerFace.size() );
+
+	parallelForFaces(
+		mesh, canceller,
+		[&] ( size_t face ) {
+			// `polygonNormal()` needs an iterator over positions,
+			// so gather them into a small buffer first.
+			V3f facePoints[16];
+			vector<V3f> facePointsStorage;
+			const int numVertices = verticesPerFace[face];
+			V3f *facePointsBegin = facePoints;
+			if( numVertices > 16 )
+			{
+				facePointsStorage.resize( numVertices );
+				facePointsBegin = facePointsStorage.data();
+			}
+			for( int i = 0; i < numVertices; ++i )
+			{
+				facePointsBegin[i] = points[vertexIds[offsets[face]+i]];
+			}
+			normals[face] = polygonNormal( facePointsBegin, facePointsBegin + numVertices );
+		}
+	);
+
+	return PrimitiveVariable( PrimitiveVariable::Uniform, normalsData );
+}
+
+CurvesPrimitivePtr MeshAlgo::wireframe( const MeshPrimitive *mesh, const std::string &position, const Canceller *canceller )
+{
+	auto it = mesh->variables.find( position );
+	if( it == mesh->variables.end() )
+	{
+		throw IECore::Exception( fmt::format( "MeshPrimitive has no primitive variable named \"{}\"", position ) );
+	}
+
+	return dispatch( it->second.data.get(), MakeWireframe(), mesh, it->first, it->second, canceller );
+}
@@ -38,6 +38,9 @@
 
 #include "IECore/Exception.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 using namespace std;
 using namespace IECoreScenePreview;
 
@@ -82,6 +85,58 @@ Renderer::ObjectInterfacePtr Renderer::camera( const std::string &name,  const s
 	return camera( name, samples[0], attributes );
 }
 
+void Renderer::objects( const std::vector<ObjectDescription> &objects, std::vector<ObjectInterfacePtr> &result )
+{
+	result.assign( objects.size(), nullptr );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, objects.size() ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const ObjectDescription &description = objects[i];
+				if( description.samples.empty() )
+				{
+					continue;
+				}
+
+				ObjectInterfacePtr objectInterface;
+				if( description.sampleTimes.empty() )
+				{
+					objectInterface = object( description.name, description.samples[0], description.attributes );
+				}
+				else
+				{
+					objectInterface = object( description.name, description.samples, description.sampleTimes, description.attributes );
+				}
+
+				if( !objectInterface )
+				{
+					continue;
+				}
+
+				if( description.transformSamples.size() && description.transformTimes.empty() )
+				{
+					objectInterface->transform( description.transformSamples[0] );
+				}
+				else if( description.transformSamples.size() )
+				{
+					objectInterface->transform( description.transformSamples, description.transformTimes );
+				}
+
+				for( const auto &[type, linkedObjects] : description.links )
+				{
+					objectInterface->link( type, linkedObjects );
+				}
+
+				result[i] = objectInterface;
+			}
+		},
+		taskGroupContext
+	);
+}
+
 IECore::DataPtr Renderer::command( const IECore::InternedString name, const IECore::CompoundDataMap &parameters )
 {
 	throw IECore::NotImplementedException( "Renderer::command" );
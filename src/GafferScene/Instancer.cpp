@@ -47,6 +47,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/ValuePlug.h"
 #include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "IECoreScene/Primitive.h"
@@ -67,6 +68,8 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 
@@ -270,7 +273,7 @@ ConstInternedStringVectorDataPtr g_emptyNames = new InternedStringVectorData();
 struct IdData
 {
 	IdData() :
-		intElements( nullptr ), int64Elements( nullptr )
+		intElements( nullptr ), int64Elements( nullptr ), data( nullptr )
 	{
 	}
 
@@ -279,14 +282,21 @@ struct IdData
 		if( const IntVectorData *intData = primitive->variableData<IntVectorData>( name ) )
 		{
 			intElements = &intData->readable();
+			data = intData;
 		}
 		else if( const Int64VectorData *int64Data = primitive->variableData<Int64VectorData>( name ) )
 		{
 			int64Elements = &int64Data->readable();
+			data = int64Data;
 		}
 
 	}
 
+	IECore::MurmurHash hash() const
+	{
+		return data ? data->Object::hash() : IECore::MurmurHash();
+	}
+
 	size_t size() const
 	{
 		if( intElements )
@@ -317,9 +327,144 @@ struct IdData
 
 	const std::vector<int> *intElements;
 	const std::vector<int64_t> *int64Elements;
+	const Data *data;
 
 };
 
+// Maps from instance ids to point indices, along with the point indices that
+// must be omitted because they share an id with another point. This depends only
+// on the id primitive variable, so we share it between engines via a cache keyed
+// on the content of the ids. This means that when only positions or other
+// primitive variables are animated, we don't need to rebuild the hash map.
+struct IdTable : public IECore::RefCounted
+{
+
+	using IdsToPointIndices = std::unordered_map<int64_t, size_t>;
+
+	IdTable( const IdData &ids, bool omitDuplicateIds )
+	{
+		const size_t numPoints = ids.size();
+		idsToPointIndices.reserve( numPoints );
+		for( size_t i = 0; i < numPoints; ++i )
+		{
+			int64_t id = ids.element(i);
+			auto ins = idsToPointIndices.try_emplace( id, i );
+			if( !ins.second )
+			{
+				// We have multiple indices trying to use this id.
+				if( !omitDuplicateIds )
+				{
+					throw IECore::Exception( fmt::format( "Instance id \"{}\" is duplicated at index {} and {}. This probably indicates invalid source data, if you want to hack around it, you can set \"omitDuplicateIds\".", id, ins.first->second, i ) );
+				}
+
+				if( !duplicateIndices.size() )
+				{
+					duplicateIndices.resize( numPoints, false );
+				}
+
+				// If we're omitting duplicate ids, then we need to omit both the current index, and
+				// the index that first tried to use this id.
+				duplicateIndices[ i ] = true;
+				duplicateIndices[ ins.first->second ] = true;
+			}
+		}
+	}
+
+	size_t memoryUsage() const
+	{
+		return
+			sizeof( IdTable ) +
+			idsToPointIndices.size() * ( sizeof( IdsToPointIndices::value_type ) + 2 * sizeof( void * ) ) +
+			idsToPointIndices.bucket_count() * sizeof( void * ) +
+			duplicateIndices.capacity() / 8
+		;
+	}
+
+	IdsToPointIndices idsToPointIndices;
+	std::vector<bool> duplicateIndices;
+
+};
+
+IE_CORE_DECLAREPTR( IdTable );
+
+struct IdTableGetterKey
+{
+
+	IdTableGetterKey( const IdData &ids, bool omitDuplicateIds )
+		:	ids( ids ), omitDuplicateIds( omitDuplicateIds )
+	{
+		hash = ids.hash();
+		hash.append( omitDuplicateIds );
+	}
+
+	operator const IECore::MurmurHash &() const
+	{
+		return hash;
+	}
+
+	const IdData &ids;
+	const bool omitDuplicateIds;
+	IECore::MurmurHash hash;
+
+};
+
+// Wraps an LRUCache used to share data between engines. Because this data
+// outlives the engines in the compute cache, we limit it to a fraction of
+// the compute cache's memory limit, following any changes made by
+// `ValuePlug::setCacheMemoryLimit()`. A limit of 0 disables the cache.
+template<typename Cache>
+class ComputeLimitedCache
+{
+
+	public :
+
+		ComputeLimitedCache( const typename Cache::GetterFunction &getter )
+			:	m_limit( limit() ), m_cache( getter, m_limit )
+		{
+		}
+
+		Cache &get()
+		{
+			const size_t l = limit();
+			if( l != m_limit )
+			{
+				tbb::spin_mutex::scoped_lock lock( m_mutex );
+				if( l != m_limit )
+				{
+					m_cache.setMaxCost( l );
+					m_limit = l;
+				}
+			}
+			return m_cache;
+		}
+
+	private :
+
+		static size_t limit()
+		{
+			return Gaffer::ValuePlug::getCacheMemoryLimit() / 4;
+		}
+
+		std::atomic_size_t m_limit;
+		tbb::spin_mutex m_mutex;
+		Cache m_cache;
+
+};
+
+using IdTableCache = IECorePreview::LRUCache<IECore::MurmurHash, ConstIdTablePtr, IECorePreview::LRUCachePolicy::Parallel, IdTableGetterKey>;
+
+IdTableCache &idTableCache()
+{
+	static ComputeLimitedCache<IdTableCache> g_cache(
+		[] ( const IdTableGetterKey &key, size_t &cost, const IECore::Canceller *canceller ) {
+			ConstIdTablePtr result = new IdTable( key.ids, key.omitDuplicateIds );
+			cost = result->memoryUsage();
+			return result;
+		}
+	);
+	return g_cache.get();
+}
+
 // We create a seed integer that corresponds to the id by hashing the id and then modulo'ing to
 // numSeeds, to create seeds in the range 0 .. numSeeds-1 that persistently correspond to the ids,
 // with a grouping pattern that can be changed with seedScramble
@@ -472,31 +617,17 @@ class Instancer::EngineData : public Data
 
 			if( m_ids.size() )
 			{
-				for( size_t i = 0, e = numPoints(); i < e; ++i )
-				{
-					int64_t id = m_ids.element(i);
-					auto ins = m_idsToPointIndices.try_emplace( id, i );
-					if( !ins.second )
-					{
-						// We have multiple indices trying to use this id.
-						if( !omitDuplicateIds )
-						{
-							throw IECore::Exception( fmt::format( "Instance id \"{}\" is duplicated at index {} and {}. This probably indicates invalid source data, if you want to hack around it, you can set \"omitDuplicateIds\".", id, m_idsToPointIndices[id], i ) );
-						}
-
-						if( !m_indicesInactive.size() )
-						{
-							m_indicesInactive.resize( numPoints(), false );
-						}
-
-						// If we're omitting duplicate ids, then we need to omit both the current index, and
-						// the index that first tried to use this id.
-						m_indicesInactive[ i ] = true;
-						m_indicesInactive[ ins.first->second ] = true;
-					}
-				}
+				m_idTable = idTableCache().get( IdTableGetterKey( m_ids, omitDuplicateIds ) );
+				m_indicesInactive = m_idTable->duplicateIndices;
 			}
 
+			// Hash everything that affects which points are inactive. Along with
+			// `m_prototypeIndicesHash`, this determines which points belong to each
+			// prototype, allowing EngineSplitPrototypesData to reuse a previous
+			// assignment when only positions or other primitive variables change.
+			m_indicesInactiveHash.append( m_ids.hash() );
+			m_indicesInactiveHash.append( omitDuplicateIds );
+
 			std::vector<std::string> inactiveIdVarNames;
 			IECore::StringAlgo::tokenize( inactiveIds, ' ', inactiveIdVarNames );
 			for( std::string &inactiveIdVarName : inactiveIdVarNames )
@@ -509,6 +640,8 @@ class Instancer::EngineData : public Data
 				const PrimitiveVariable *vertexInactiveVar = findVertexVariable( m_primitive.get(), inactiveIdVarName );
 				if( vertexInactiveVar )
 				{
+					m_indicesInactiveHash.append( 0 );
+					m_indicesInactiveHash.append( vertexInactiveVar->data->Object::hash() );
 					if( IECore::size( vertexInactiveVar->data.get() ) != numPoints() )
 					{
 						throw IECore::Exception( fmt::format( "Inactive primitive variable \"{}\" has incorrect size", inactiveIdVarName ) );
@@ -569,17 +702,20 @@ class Instancer::EngineData : public Data
 					continue;
 				}
 
+				m_indicesInactiveHash.append( 1 );
+				m_indicesInactiveHash.append( idData.hash() );
+
 				if( !m_indicesInactive.size() )
 				{
 					m_indicesInactive.resize( numPoints(), false );
 				}
 
-				if( m_idsToPointIndices.size() )
+				if( m_idTable )
 				{
 					for( size_t i = 0; i < idSize; i++ )
 					{
-						auto it = m_idsToPointIndices.find( idData.element(i) );
-						if( it == m_idsToPointIndices.end() )
+						auto it = m_idTable->idsToPointIndices.find( idData.element(i) );
+						if( it == m_idTable->idsToPointIndices.end() )
 						{
 							// I wish I could throw here ... it would be a really helpful clue to get an error
 							// if you've accidentally chosen a bad id. But ids might be changing over time, so
@@ -643,8 +779,8 @@ class Instancer::EngineData : public Data
 				return i;
 			}
 
-			IdsToPointIndices::const_iterator it = m_idsToPointIndices.find( i );
-			if( it == m_idsToPointIndices.end() )
+			IdTable::IdsToPointIndices::const_iterator it = m_idTable->idsToPointIndices.find( i );
+			if( it == m_idTable->idsToPointIndices.end() )
 			{
 				throw IECore::Exception( fmt::format( "Instance id \"{}\" is invalid. Topology may have changed during shutter.", i ) );
 			}
@@ -723,27 +859,66 @@ class Instancer::EngineData : public Data
 		M44f instanceTransform( size_t pointIndex ) const
 		{
 			M44f result;
-			if( m_positions )
+			instanceTransforms( &pointIndex, 1, &result );
+			return result;
+		}
+
+		// Equivalent to calling `instanceTransform()` for each of `numIndices` point indices,
+		// but significantly faster. Rather than test for each primitive variable and
+		// perform full matrix multiplications per point, we make a separate pass over the
+		// batch for each component, writing the rotation, scale and translation directly
+		// into the matrices. Since the matrix for each component is sparse, this gives
+		// identical results to composing them via multiplication.
+		void instanceTransforms( const size_t *pointIndices, size_t numIndices, M44f *transforms ) const
+		{
+			if( m_orientations )
 			{
-				result.translate( (*m_positions)[pointIndex] );
+				for( size_t i = 0; i < numIndices; ++i )
+				{
+					// Using Orientation::normalizedIfNeeded avoids modifying quaternions that are already
+					// normalized. It's better for consistency to not be pointlessly changing the values
+					// slightly at the limits of floating point precision, when they're already as close to
+					// normalized as they can get, and this saves 4% runtime on InstancerTest.testBoundPerformance.
+					transforms[i] = Orientation::normalizedIfNeeded( (*m_orientations)[pointIndices[i]] ).toMatrix44();
+				}
 			}
-			if( m_orientations )
+			else
 			{
-				// Using Orientation::normalizedIfNeeded avoids modifying quaternions that are already
-				// normalized. It's better for consistency to not be pointlessly changing the values
-				// slightly at the limits of floating point precision, when they're already as close to
-				// normalized as they can get, and this saves 4% runtime on InstancerTest.testBoundPerformance.
-				result = Orientation::normalizedIfNeeded((*m_orientations)[pointIndex]).toMatrix44() * result;
+				std::fill( transforms, transforms + numIndices, M44f() );
 			}
+
 			if( m_scales )
 			{
-				result.scale( (*m_scales)[pointIndex] );
+				for( size_t i = 0; i < numIndices; ++i )
+				{
+					const V3f &s = (*m_scales)[pointIndices[i]];
+					float (*m)[4] = transforms[i].x;
+					m[0][0] *= s[0]; m[0][1] *= s[0]; m[0][2] *= s[0];
+					m[1][0] *= s[1]; m[1][1] *= s[1]; m[1][2] *= s[1];
+					m[2][0] *= s[2]; m[2][1] *= s[2]; m[2][2] *= s[2];
+				}
 			}
-			if( m_uniformScales )
+			else if( m_uniformScales )
 			{
-				result.scale( V3f( (*m_uniformScales)[pointIndex] ) );
+				for( size_t i = 0; i < numIndices; ++i )
+				{
+					const float s = (*m_uniformScales)[pointIndices[i]];
+					float (*m)[4] = transforms[i].x;
+					m[0][0] *= s; m[0][1] *= s; m[0][2] *= s;
+					m[1][0] *= s; m[1][1] *= s; m[1][2] *= s;
+					m[2][0] *= s; m[2][1] *= s; m[2][2] *= s;
+				}
+			}
+
+			if( m_positions )
+			{
+				for( size_t i = 0; i < numIndices; ++i )
+				{
+					const V3f &p = (*m_positions)[pointIndices[i]];
+					float (*m)[4] = transforms[i].x;
+					m[3][0] = p[0]; m[3][1] = p[1]; m[3][2] = p[2];
+				}
 			}
-			return result;
 		}
 
 		size_t numInstanceAttributes() const
@@ -979,6 +1154,7 @@ class Instancer::EngineData : public Data
 						{
 							throw IECore::Exception( fmt::format( "prototypeIndex primitive variable \"{}\" has incorrect size", prototypeIndex ) );
 						}
+						m_prototypeIndicesHash.append( prototypeIndices->Object::hash() );
 					}
 
 					rootStrings = &rootsList->readable();
@@ -994,6 +1170,7 @@ class Instancer::EngineData : public Data
 						{
 							throw IECore::Exception( fmt::format( "prototypeIndex primitive variable \"{}\" has incorrect size", prototypeIndex ) );
 						}
+						m_prototypeIndicesHash.append( prototypeIndices->Object::hash() );
 					}
 
 					const auto *roots = m_primitive->variableData<StringVectorData>( rootsVariable, PrimitiveVariable::Constant );
@@ -1036,6 +1213,13 @@ class Instancer::EngineData : public Data
 					m_prototypeIndices = view->indices();
 					rootStrings = &view->data();
 
+					const PrimitiveVariable &rootsPrimitiveVariable = m_primitive->variables.find( rootsVariable )->second;
+					m_prototypeIndicesHash.append( rootsPrimitiveVariable.data->Object::hash() );
+					if( rootsPrimitiveVariable.indices )
+					{
+						m_prototypeIndicesHash.append( rootsPrimitiveVariable.indices->Object::hash() );
+					}
+
 					if( !m_prototypeIndices )
 					{
 						std::unordered_map<std::string, int> duplicateRootMap;
@@ -1125,6 +1309,8 @@ class Instancer::EngineData : public Data
 			m_numPrototypes = m_prototypeIndexRemap.size();
 			m_numValidPrototypes = outputChildNames.size();
 
+			m_prototypeIndicesHash.append( m_prototypeIndexRemap.data(), m_prototypeIndexRemap.size() );
+
 		}
 
 		IECoreScene::ConstPrimitivePtr m_primitive;
@@ -1147,8 +1333,7 @@ class Instancer::EngineData : public Data
 		const std::vector<Imath::V3f> *m_scales;
 		const std::vector<float> *m_uniformScales;
 
-		using IdsToPointIndices = std::unordered_map <int64_t, size_t>;
-		IdsToPointIndices m_idsToPointIndices;
+		ConstIdTablePtr m_idTable;
 
 		boost::container::flat_map<InternedString, AttributeCreator> m_attributeCreators;
 		MurmurHash m_attributesHash;
@@ -1157,6 +1342,9 @@ class Instancer::EngineData : public Data
 
 		std::vector<bool> m_indicesInactive;
 
+		IECore::MurmurHash m_prototypeIndicesHash;
+		IECore::MurmurHash m_indicesInactiveHash;
+
 		friend Instancer::EngineSplitPrototypesData;
 };
 
@@ -1190,15 +1378,96 @@ class Instancer::EngineSplitPrototypesData : public Data
 				}
 			}
 
-			// We need a list of which point indices belong to each prototype
-			std::vector< std::vector<size_t> > pointIndicesForPrototypeIndex( m_engineData->m_numPrototypes );
+			// We need a list of which point indices belong to each prototype. This depends only on the
+			// prototype indices and the inactive points, so we can share it between engines which differ
+			// only in positions or other primitive variables, for instance when positions are animated.
+			const PointIndicesGetterKey key( m_engineData.get(), constantPrototypeIndex );
+			m_pointIndicesForPrototypeIndex = pointIndicesCache().get( key );
+
+			// We've populated a list of point indices for each prototype index. When we need this, however,
+			// we need it indexed by name, so we build a map from name to the vectors we've just retrieved.
+			const std::vector< InternedString > &outputChildNames = m_engineData->m_names->outputChildNames()->readable();
+			for( unsigned int i = 0; i < m_engineData->m_numPrototypes; i++ )
+			{
+				int prototypeIndex = m_engineData->m_prototypeIndexRemap[ i ];
+				if( prototypeIndex == -1 )
+				{
+					continue;
+				}
+
+				m_pointIndicesForPrototype.emplace(
+					IECore::InternedString( outputChildNames[prototypeIndex] ),
+					&m_pointIndicesForPrototypeIndex->pointIndices[prototypeIndex]
+				);
+			}
+		}
+
+		const EngineData *engine() const
+		{
+			return m_engineData.get();
+		}
+
+		const std::vector<size_t> & pointIndicesForPrototype( const IECore::InternedString &prototypeName ) const
+		{
+			return *m_pointIndicesForPrototype.at( prototypeName );
+		}
+
+
+	protected :
+
+		struct PointIndices : public IECore::RefCounted
+		{
+			std::vector< std::vector<size_t> > pointIndices;
+		};
+		IE_CORE_DECLAREPTR( PointIndices );
+
+		struct PointIndicesGetterKey
+		{
+
+			PointIndicesGetterKey( const EngineData *engineData, int constantPrototypeIndex )
+				:	engineData( engineData ), constantPrototypeIndex( constantPrototypeIndex )
+			{
+				hash = engineData->m_prototypeIndicesHash;
+				hash.append( engineData->m_indicesInactiveHash );
+				hash.append( (uint64_t)engineData->numPoints() );
+				hash.append( (uint64_t)engineData->m_numPrototypes );
+			}
+
+			operator const IECore::MurmurHash &() const
+			{
+				return hash;
+			}
+
+			const EngineData *engineData;
+			const int constantPrototypeIndex;
+			IECore::MurmurHash hash;
+
+		};
+
+		using PointIndicesCache = IECorePreview::LRUCache<IECore::MurmurHash, ConstPointIndicesPtr, IECorePreview::LRUCachePolicy::Parallel, PointIndicesGetterKey>;
+
+		static PointIndicesCache &pointIndicesCache()
+		{
+			static ComputeLimitedCache<PointIndicesCache> g_cache( computePointIndices );
+			return g_cache.get();
+		}
+
+		static ConstPointIndicesPtr computePointIndices( const PointIndicesGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+		{
+			const EngineData *engineData = key.engineData;
+			const int constantPrototypeIndex = key.constantPrototypeIndex;
+
+			PointIndicesPtr result = new PointIndices;
+			std::vector< std::vector<size_t> > &pointIndicesForPrototypeIndex = result->pointIndices;
+			pointIndicesForPrototypeIndex.resize( engineData->m_numPrototypes );
+
 			// Pre allocate if there's just one prototype, since we know the length will just be every point
 			if( constantPrototypeIndex != -1 )
 			{
-				pointIndicesForPrototypeIndex[ constantPrototypeIndex ].reserve( m_engineData->numPoints() );
+				pointIndicesForPrototypeIndex[ constantPrototypeIndex ].reserve( engineData->numPoints() );
 			}
 
-			if( constantPrototypeIndex != -1 && !m_engineData->m_indicesInactive.size() )
+			if( constantPrototypeIndex != -1 && !engineData->m_indicesInactive.size() )
 			{
 				// If there's a single prototype, and no indices are being omitted because they are duplicates,
 				// then the list of point indices for the prototype is just an identity map of all integers
@@ -1206,7 +1475,7 @@ class Instancer::EngineSplitPrototypesData : public Data
 				//
 				// It's pretty wasteful to store this, but it avoids special cases throughout this code to skip
 				// using pointIndicesForPrototypeIndex when it isn't needed
-				for( size_t i = 0, e = m_engineData->numPoints(); i < e; ++i )
+				for( size_t i = 0, e = engineData->numPoints(); i < e; ++i )
 				{
 					pointIndicesForPrototypeIndex[ constantPrototypeIndex ].push_back( i );
 				}
@@ -1215,10 +1484,10 @@ class Instancer::EngineSplitPrototypesData : public Data
 			{
 				// The assignment of point indices to prototypes is non-trivial, so we actually have to do
 				// a bit of work
-				for( size_t i = 0, e = m_engineData->numPoints(); i < e; ++i )
+				for( size_t i = 0, e = engineData->numPoints(); i < e; ++i )
 				{
 					// Add this point index to the list for its prototype
-					int protoIndex = m_engineData->prototypeIndex( i );
+					int protoIndex = engineData->prototypeIndex( i );
 
 					if( protoIndex != -1 )
 					{
@@ -1227,37 +1496,18 @@ class Instancer::EngineSplitPrototypesData : public Data
 				}
 			}
 
-			// We've populated instancerPrototypeIndex with a list of point indices for each prototype index.
-			// When we need this, however, we need it indexed by name, so we move the vectors we've just built
-			// to m_pointIndicesForPrototype which is indexed by name.
-			const std::vector< InternedString > &outputChildNames = m_engineData->m_names->outputChildNames()->readable();
-			for( unsigned int i = 0; i < m_engineData->m_numPrototypes; i++ )
+			cost = sizeof( PointIndices );
+			for( const auto &v : pointIndicesForPrototypeIndex )
 			{
-				int prototypeIndex = m_engineData->m_prototypeIndexRemap[ i ];
-				if( prototypeIndex == -1 )
-				{
-					continue;
-				}
-
-				m_pointIndicesForPrototype.emplace( IECore::InternedString( outputChildNames[prototypeIndex] ), std::move( pointIndicesForPrototypeIndex[prototypeIndex] ) );
+				cost += v.capacity() * sizeof( size_t ) + sizeof( v );
 			}
-		}
-
-		const EngineData *engine() const
-		{
-			return m_engineData.get();
-		}
 
-		const std::vector<size_t> & pointIndicesForPrototype( const IECore::InternedString &prototypeName ) const
-		{
-			return m_pointIndicesForPrototype.at( prototypeName );
+			return result;
 		}
 
-
-	protected :
-
 		ConstEngineDataPtr m_engineData;
-		std::unordered_map< InternedString, std::vector<size_t> > m_pointIndicesForPrototype;
+		ConstPointIndicesPtr m_pointIndicesForPrototypeIndex;
+		std::unordered_map< InternedString, const std::vector<size_t> * > m_pointIndicesForPrototype;
 };
 
 
@@ -2490,13 +2740,20 @@ Imath::Box3f Instancer::computeBranchBound( const ScenePath &sourcePath, const S
 		return parallel_reduce(
 			tbb::blocked_range<size_t>( 0, pointIndicesForPrototype.size() ),
 			Box3f(),
-			[ pointIndicesForPrototype, &e, &childBound, &childTransform ] ( const tbb::blocked_range<size_t> &r, Box3f u ) {
-				for( size_t i = r.begin(); i != r.end(); ++i )
+			[ &pointIndicesForPrototype, &e, &childBound, &childTransform ] ( const tbb::blocked_range<size_t> &r, Box3f u ) {
+				// Compute instance transforms in batches, which is much quicker than computing
+				// them one at a time.
+				const size_t batchSize = 256;
+				M44f transforms[batchSize];
+				for( size_t batchBegin = r.begin(); batchBegin < r.end(); batchBegin += batchSize )
 				{
-					const size_t pointIndex = pointIndicesForPrototype[i];
-					const M44f m = childTransform * e->instanceTransform( pointIndex );
-					const Box3f b = transform( childBound, m );
-					u.extendBy( b );
+					const size_t batchEnd = std::min( batchBegin + batchSize, r.end() );
+					e->instanceTransforms( pointIndicesForPrototype.data() + batchBegin, batchEnd - batchBegin, transforms );
+					for( size_t i = 0, n = batchEnd - batchBegin; i < n; ++i )
+					{
+						const Box3f b = transform( childBound, childTransform * transforms[i] );
+						u.extendBy( b );
+					}
 				}
 				return u;
 			},
@@ -3353,6 +3610,12 @@ void Instancer::InstancerCapsule::render( IECoreScenePreview::Renderer *renderer
 	// than 32 threads, which appears to help some in testing.
 	size_t grainSize = std::max( (size_t)1, engines[0]->numPoints() / 32 );
 
+	// Within each task, we process instances in fixed size chunks. For each chunk we first find the
+	// prototypes, and then compute all the transforms in a batch, before outputting the instances
+	// to the renderer. The renderer takes ownership of each instance as soon as it is output, so
+	// the only storage we need is per-chunk, and is reused for every chunk in the task.
+	const size_t chunkSize = 1024;
+
 	tbb::parallel_for( tbb::blocked_range<size_t>( 0, engines[0]->numPoints(), grainSize ),
 		[&]( const tbb::blocked_range<size_t> &r )
 		{
@@ -3366,129 +3629,167 @@ void Instancer::InstancerCapsule::render( IECoreScenePreview::Renderer *renderer
 			std::vector< std::string > names( engines[0]->numValidPrototypes() );
 			std::vector< int > namePrefixLengths( engines[0]->numValidPrototypes() );
 
-			for( size_t pointIndex = r.begin(); pointIndex != r.end(); ++pointIndex )
+			// Per-chunk storage
+			std::vector<size_t> chunkPointIndices; chunkPointIndices.reserve( chunkSize );
+			std::vector<int> chunkPrototypeIndices; chunkPrototypeIndices.reserve( chunkSize );
+			std::vector<const Prototype *> chunkPrototypes; chunkPrototypes.reserve( chunkSize );
+			std::vector<size_t> samplePointIndices;
+			std::vector<M44f> chunkTransforms( chunkSize * sampleTimes.size() );
+
+			for( size_t chunkBegin = r.begin(); chunkBegin < r.end(); chunkBegin += chunkSize )
 			{
-				int protoIndex = engines[0]->prototypeIndex( pointIndex );
-				if( protoIndex == -1 )
-				{
-					// Invalid prototype
-					continue;
-				}
+				const size_t chunkEnd = std::min( chunkBegin + chunkSize, r.end() );
 
-				const Prototype *proto;
-				if( fixedPrototypes.size() )
-				{
-					proto = fixedPrototypes[protoIndex].get();
-				}
-				else
+				chunkPointIndices.clear();
+				chunkPrototypeIndices.clear();
+				chunkPrototypes.clear();
+
+				for( size_t pointIndex = chunkBegin; pointIndex != chunkEnd; ++pointIndex )
 				{
-					// The prototype depends on the context, so we need to find the prototype context for
-					// this instance.
+					int protoIndex = engines[0]->prototypeIndex( pointIndex );
+					if( protoIndex == -1 )
+					{
+						// Invalid prototype
+						continue;
+					}
 
+					const Prototype *proto;
+					if( fixedPrototypes.size() )
+					{
+						proto = fixedPrototypes[protoIndex].get();
+					}
+					else
+					{
+						// The prototype depends on the context, so we need to find the prototype context for
+						// this instance.
+
+
+						// We find the capsules using the engine at shutter open, but the time used to construct the capsules
+						// must be the on-frame time, since the capsules will add their own shutter ( and we also handle
+						// the shutter ourselves for transform matrices )
+						//
+						// For most context variables, we are overwriting them for each prototype anyway, so
+						// we can reuse the context. But timeOffset is relative, so it's important that we reset the
+						// time before we do setPrototypeContextVariables for the next element. ( Should this be more
+						// general instead of assuming that frame is the only variable for which offsetMode may be set? )
+						prototypeScope.setFrame( onFrameTime );
 
-					// We find the capsules using the engine at shutter open, but the time used to construct the capsules
-					// must be the on-frame time, since the capsules will add their own shutter ( and we also handle
-					// the shutter ourselves for transform matrices )
-					//
-					// For most context variables, we are overwriting them for each prototype anyway, so
-					// we can reuse the context. But timeOffset is relative, so it's important that we reset the
-					// time before we do setPrototypeContextVariables for the next element. ( Should this be more
-					// general instead of assuming that frame is the only variable for which offsetMode may be set? )
-					prototypeScope.setFrame( onFrameTime );
+						engines[0]->setPrototypeContextVariables( pointIndex, prototypeScope );
 
-					engines[0]->setPrototypeContextVariables( pointIndex, prototypeScope );
+						proto = prototypeCache.get( PrototypeCacheGetterKey( protoIndex, prototypeScope.context() ) ).get();
+					}
+
+					if( !proto->m_object.size() )
+					{
+						// No object to render. This could happen if the protype didn't meet the
+						// RenderOptions::purposeIncluded test.
+						continue;
+					}
 
-					proto = prototypeCache.get( PrototypeCacheGetterKey( protoIndex, prototypeScope.context() ) ).get();
+					chunkPointIndices.push_back( pointIndex );
+					chunkPrototypeIndices.push_back( protoIndex );
+					chunkPrototypes.push_back( proto );
 				}
 
-				if( !proto->m_object.size() )
+				const size_t numChunkInstances = chunkPointIndices.size();
+				engines[0]->instanceTransforms( chunkPointIndices.data(), numChunkInstances, chunkTransforms.data() );
+				for( size_t i = 1; i < engines.size(); ++i )
 				{
-					// No object to render. This could happen if the protype didn't meet the
-					// RenderOptions::purposeIncluded test.
-					continue;
+					samplePointIndices.resize( numChunkInstances );
+					for( size_t j = 0; j < numChunkInstances; ++j )
+					{
+						samplePointIndices[j] = engines[i]->pointIndex( engines[0]->instanceId( chunkPointIndices[j] ) );
+					}
+					engines[i]->instanceTransforms( samplePointIndices.data(), numChunkInstances, chunkTransforms.data() + i * chunkSize );
 				}
 
-				IECoreScenePreview::Renderer::AttributesInterface *attribs;
-				if( hasAttributes )
+				for( size_t chunkIndex = 0; chunkIndex < numChunkInstances; ++chunkIndex )
 				{
-					CompoundObjectPtr currentAttributes = new CompoundObject();
+					const size_t pointIndex = chunkPointIndices[chunkIndex];
+					const int protoIndex = chunkPrototypeIndices[chunkIndex];
+					const Prototype *proto = chunkPrototypes[chunkIndex];
 
-					// Since we're not going to modify any existing members (only add new ones),
-					// and our result is only read in this function, and never written, we can
-					// directly reference the input members in our result without copying. Be
-					// careful not to modify them though!
-					currentAttributes->members() = proto->m_attributes->members();
+					IECoreScenePreview::Renderer::AttributesInterface *attribs;
+					if( hasAttributes )
+					{
+						CompoundObjectPtr currentAttributes = new CompoundObject();
 
-					engines[0]->instanceAttributes( pointIndex, *currentAttributes );
-					attribsStorage = renderer->attributes( currentAttributes.get() );
-					attribs = attribsStorage.get();
-				}
-				else
-				{
-					attribs = proto->m_rendererAttributes.get();
-				}
+						// Since we're not going to modify any existing members (only add new ones),
+						// and our result is only read in this function, and never written, we can
+						// directly reference the input members in our result without copying. Be
+						// careful not to modify them though!
+						currentAttributes->members() = proto->m_attributes->members();
 
-				int64_t instanceId = engines[0]->instanceId( pointIndex );
+						engines[0]->instanceAttributes( pointIndex, *currentAttributes );
+						attribsStorage = renderer->attributes( currentAttributes.get() );
+						attribs = attribsStorage.get();
+					}
+					else
+					{
+						attribs = proto->m_rendererAttributes.get();
+					}
 
+					int64_t instanceId = engines[0]->instanceId( pointIndex );
 
-				if( !namePrefixLengths[protoIndex] )
-				{
-					// If we haven't allocated a name for this prototype index, allocate it now,
-					// including additional storage that will hold the digits for each instance id
-					const std::string &protoName = engines[0]->prototypeNames()->readable()[ protoIndex ].string();
-					names[protoIndex].reserve( protoName.size() + std::numeric_limits< int64_t >::digits10 + 1 );
-					names[protoIndex] += protoName;
-					names[protoIndex].append( 1, '/' );
-					namePrefixLengths[protoIndex] = names[protoIndex].size();
-				}
 
-				// Create a name by concatenating the name of the prototype with digits of the current
-				// instance id.
-				// Including the prototype name is not necessary for uniqueness ( the instance ids are
-				// already unique ), but doing this keeps the names more consistent with how things end
-				// up being named when they use the non-encapsulated hierarchy.
-				std::string &name = names[ protoIndex ];
-				const int prefixLen = namePrefixLengths[ protoIndex ];
-				name.resize( namePrefixLengths[protoIndex] + std::numeric_limits< int64_t >::digits10 + 1 );
-				name.resize( std::to_chars( &name[prefixLen], &(*name.end()), instanceId ).ptr - &name[0] );
-
-				IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface;
-				if( proto->m_objectSampleTimes.size() )
-				{
-					objectInterface = renderer->object(
-						name, proto->m_objectPointers, proto->m_objectSampleTimes, attribs
-					);
-				}
-				else
-				{
-					objectInterface = renderer->object(
-						name, proto->m_object[0].get(), attribs
-					);
-				}
+					if( !namePrefixLengths[protoIndex] )
+					{
+						// If we haven't allocated a name for this prototype index, allocate it now,
+						// including additional storage that will hold the digits for each instance id
+						const std::string &protoName = engines[0]->prototypeNames()->readable()[ protoIndex ].string();
+						names[protoIndex].reserve( protoName.size() + std::numeric_limits< int64_t >::digits10 + 1 );
+						names[protoIndex] += protoName;
+						names[protoIndex].append( 1, '/' );
+						namePrefixLengths[protoIndex] = names[protoIndex].size();
+					}
 
-				if( sampleTimes.size() == 1 )
-				{
-					objectInterface->transform( proto->m_transforms[0] * engines[0]->instanceTransform( pointIndex ) );
-				}
-				else
-				{
-					for( unsigned int i = 0; i < engines.size(); i++ )
+					// Create a name by concatenating the name of the prototype with digits of the current
+					// instance id.
+					// Including the prototype name is not necessary for uniqueness ( the instance ids are
+					// already unique ), but doing this keeps the names more consistent with how things end
+					// up being named when they use the non-encapsulated hierarchy.
+					std::string &name = names[ protoIndex ];
+					const int prefixLen = namePrefixLengths[ protoIndex ];
+					name.resize( namePrefixLengths[protoIndex] + std::numeric_limits< int64_t >::digits10 + 1 );
+					name.resize( std::to_chars( &name[prefixLen], &(*name.end()), instanceId ).ptr - &name[0] );
+
+					IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface;
+					if( proto->m_objectSampleTimes.size() )
+					{
+						objectInterface = renderer->object(
+							name, proto->m_objectPointers, proto->m_objectSampleTimes, attribs
+						);
+					}
+					else
 					{
-						int curPointIndex = i == 0 ? pointIndex : engines[i]->pointIndex( instanceId );
-						pointTransforms[i] = proto->m_transforms[i] * engines[i]->instanceTransform( curPointIndex );
+						objectInterface = renderer->object(
+							name, proto->m_object[0].get(), attribs
+						);
 					}
 
-					objectInterface->transform( pointTransforms, sampleTimes );
-				}
+					if( sampleTimes.size() == 1 )
+					{
+						objectInterface->transform( proto->m_transforms[0] * chunkTransforms[chunkIndex] );
+					}
+					else
+					{
+						for( unsigned int i = 0; i < engines.size(); i++ )
+						{
+							pointTransforms[i] = proto->m_transforms[i] * chunkTransforms[i * chunkSize + chunkIndex];
+						}
 
-				if( needsInstanceIDs )
-				{
-					// We add one here so that we can distinguish between the background and an id of 0.
-					// Anything that uses these ids will need to subtract this off ( currently just
-					// ImageSelectionTool ).
-					objectInterface->assignInstanceID( pointIndex + 1 );
-				}
+						objectInterface->transform( pointTransforms, sampleTimes );
+					}
 
+					if( needsInstanceIDs )
+					{
+						// We add one here so that we can distinguish between the background and an id of 0.
+						// Anything that uses these ids will need to subtract this off ( currently just
+						// ImageSelectionTool ).
+						objectInterface->assignInstanceID( pointIndex + 1 );
+					}
+
+				}
 			}
 		},
 		taskGroupContext
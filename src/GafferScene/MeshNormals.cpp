@@ -36,6 +36,8 @@
 
 #include "GafferScene/MeshNormals.h"
 
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
+
 #include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/MeshPrimitive.h"
 
@@ -158,8 +160,8 @@ IECore::ConstObjectPtr MeshNormals::computeProcessedObject( const ScenePath &pat
 
 	if( interpolation == PrimitiveVariable::Uniform )
 	{
-		meshWithNormals->variables[ normal ] = MeshAlgo::calculateUniformNormals(
-			meshWithNormals.get(), position
+		meshWithNormals->variables[ normal ] = IECoreScenePreview::MeshAlgo::calculateUniformNormals(
+			meshWithNormals.get(), position, context->canceller()
 		);
 	}
 	else if( interpolation == PrimitiveVariable::Vertex || interpolation == PrimitiveVariable::Varying )
@@ -42,6 +42,8 @@
 #include "IECoreScene/MeshPrimitive.h"
 #include "IECoreScene/PrimitiveEvaluator.h"
 
+#include "IECore/NullObject.h"
+
 #include "tbb/parallel_for.h"
 
 using namespace std;
@@ -149,6 +151,59 @@ OutputVariableFunction addPrimitiveVariable( Primitive *outputPrimitive, const s
 
 }
 
+// Custom Data derived class used to pass a PrimitiveEvaluator from
+// the `__sourceEvaluator` plug. We are deliberately omitting a custom
+// TypeId etc because this is just a private class.
+class EvaluatorData : public Data
+{
+
+	public :
+
+		EvaluatorData( const ConstPrimitiveEvaluatorPtr &evaluator )
+			:	m_evaluator( evaluator )
+		{
+		}
+
+		const PrimitiveEvaluator *evaluator() const
+		{
+			return m_evaluator.get();
+		}
+
+		void copyFrom( const Object *other, CopyContext *context ) override
+		{
+			Data::copyFrom( other, context );
+			msg( Msg::Warning, "EvaluatorData::copyFrom", "Not implemented" );
+		}
+
+		void save( SaveContext *context ) const override
+		{
+			Data::save( context );
+			msg( Msg::Warning, "EvaluatorData::save", "Not implemented" );
+		}
+
+		void load( LoadContextPtr context ) override
+		{
+			Data::load( context );
+			msg( Msg::Warning, "EvaluatorData::load", "Not implemented" );
+		}
+
+		void memoryUsage( Object::MemoryAccumulator &accumulator ) const override
+		{
+			// So that the compute cache can account for the size of the
+			// evaluator. This doesn't include any acceleration structures,
+			// but is the best approximation we have.
+			Data::memoryUsage( accumulator );
+			accumulator.accumulate( m_evaluator->primitive().get() );
+		}
+
+	private :
+
+		ConstPrimitiveEvaluatorPtr m_evaluator;
+
+};
+
+IE_CORE_DECLAREPTR( EvaluatorData )
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -169,6 +224,7 @@ PrimitiveSampler::PrimitiveSampler( const std::string &name )
 	addChild( new StringPlug( "primitiveVariables" ) );
 	addChild( new StringPlug( "prefix" ) );
 	addChild( new StringPlug( "status" ) );
+	addChild( new ObjectPlug( "__sourceEvaluator", Plug::Out, NullObject::defaultNullObject() ) );
 }
 
 PrimitiveSampler::~PrimitiveSampler()
@@ -225,6 +281,74 @@ const Gaffer::StringPlug *PrimitiveSampler::statusPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 4 );
 }
 
+Gaffer::ObjectPlug *PrimitiveSampler::sourceEvaluatorPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 5 );
+}
+
+const Gaffer::ObjectPlug *PrimitiveSampler::sourceEvaluatorPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 5 );
+}
+
+void PrimitiveSampler::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
+{
+	Deformer::affects( input, outputs );
+
+	if( input == sourcePlug()->objectPlug() )
+	{
+		outputs.push_back( sourceEvaluatorPlug() );
+	}
+}
+
+void PrimitiveSampler::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	Deformer::hash( output, context, h );
+
+	if( output == sourceEvaluatorPlug() )
+	{
+		sourcePlug()->objectPlug()->hash( h );
+	}
+}
+
+void PrimitiveSampler::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == sourceEvaluatorPlug() )
+	{
+		ConstObjectPtr sourceObject = sourcePlug()->objectPlug()->getValue();
+		ConstPrimitivePtr sourcePrimitive = runTimeCast<const Primitive>( sourceObject.get() );
+		if( auto mesh = runTimeCast<const MeshPrimitive>( sourcePrimitive.get() ) )
+		{
+			sourcePrimitive = MeshAlgo::triangulate( mesh, context->canceller() );
+		}
+
+		PrimitiveEvaluatorPtr evaluator = sourcePrimitive ? PrimitiveEvaluator::create( sourcePrimitive ) : nullptr;
+		if( evaluator )
+		{
+			static_cast<ObjectPlug *>( output )->setValue( new EvaluatorData( evaluator ) );
+		}
+		else
+		{
+			output->setToDefault();
+		}
+		return;
+	}
+
+	Deformer::compute( output, context );
+}
+
+Gaffer::ValuePlug::CachePolicy PrimitiveSampler::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == sourceEvaluatorPlug() )
+	{
+		// Many destination locations will typically request the
+		// evaluator concurrently, so we want them to wait for a
+		// single shared computation.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return Deformer::computeCachePolicy( output );
+}
+
 bool PrimitiveSampler::affectsProcessedObject( const Gaffer::Plug *input ) const
 {
 	return
@@ -235,6 +359,7 @@ bool PrimitiveSampler::affectsProcessedObject( const Gaffer::Plug *input ) const
 		input == statusPlug() ||
 		input == sourcePlug()->existsPlug() ||
 		input == sourcePlug()->objectPlug() ||
+		input == sourceEvaluatorPlug() ||
 		input == inPlug()->transformPlug() ||
 		input == sourcePlug()->transformPlug() ||
 		affectsSamplingFunction( input )
@@ -299,23 +424,16 @@ IECore::ConstObjectPtr PrimitiveSampler::computeProcessedObject( const ScenePath
 		return inputObject;
 	}
 
-	ConstObjectPtr sourceObject = sourcePlug()->object( sourcePath );
-	const Primitive *sourcePrimitive = runTimeCast<const Primitive>( sourceObject.get() );
-	if( !sourcePrimitive )
-	{
-		return inputObject;
-	}
-
-	ConstPrimitivePtr preprocessedSourcePrimitive = sourcePrimitive;
-	if( auto mesh = runTimeCast<const MeshPrimitive>( preprocessedSourcePrimitive.get() ) )
+	ConstObjectPtr evaluatorData;
 	{
-		preprocessedSourcePrimitive = MeshAlgo::triangulate( mesh, context->canceller() );
+		ScenePlug::PathScope pathScope( context, &sourcePath );
+		evaluatorData = sourceEvaluatorPlug()->getValue();
 	}
-	PrimitiveEvaluatorPtr evaluator = PrimitiveEvaluator::create( preprocessedSourcePrimitive );
-	if( !evaluator )
+	if( evaluatorData->typeId() == NullObjectTypeId )
 	{
 		return inputObject;
 	}
+	const PrimitiveEvaluator *evaluator = static_cast<const EvaluatorData *>( evaluatorData.get() )->evaluator();
 
 	PrimitivePtr outputPrimitive = inputPrimitive->copy();
 	const size_t size = outputPrimitive->variableSize( outputInterpolation );
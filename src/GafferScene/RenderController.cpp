@@ -48,6 +48,8 @@
 #include "IECore/Interpolator.h"
 #include "IECore/NullObject.h"
 
+#include "Imath/ImathBoxAlgo.h"
+
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/bind/bind.hpp"
 #include "boost/container/flat_set.hpp"
@@ -56,6 +58,7 @@
 #include "boost/multi_index_container.hpp"
 
 #include "tbb/parallel_for.h"
+#include "tbb/spin_mutex.h"
 
 #include "fmt/format.h"
 
@@ -640,6 +643,13 @@ class RenderController::SceneGraph
 					// Apply light links if necessary.
 					if( m_changedComponents & ( ObjectComponent | AttributesComponent ) || controller->m_lightLinks->lightLinksDirty() )
 					{
+						if( m_changedComponents & ObjectComponent )
+						{
+							// We may have a brand new ObjectInterface, which
+							// must be linked regardless of whether or not
+							// the links have changed.
+							m_lightLinksHash = IECore::MurmurHash();
+						}
 						controller->m_lightLinks->outputLightLinks( controller->m_scene.get(), m_fullAttributes.get(), m_objectInterface.get(), &m_lightLinksHash );
 					}
 				}
@@ -1252,6 +1262,124 @@ class RenderController::SceneGraph
 
 };
 
+//////////////////////////////////////////////////////////////////////////
+// CameraPriorityGatherer
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Functor for use with `SceneAlgo::parallelProcessLocations()`, gathering
+// the locations whose bounds cover at least `threshold` of the area of the
+// camera's screen window. Traversal is pruned below any location that falls
+// beneath the threshold or outside the frustum, and below any location whose
+// children aren't visible in the VisibleSet, so the cost is proportional to
+// the number of significant locations rather than the size of the scene.
+class CameraPriorityGatherer
+{
+
+	public :
+
+		struct Result
+		{
+			tbb::spin_mutex mutex;
+			IECore::PathMatcher paths;
+		};
+
+		CameraPriorityGatherer(
+			const Camera *camera, const M44f &worldToCamera, float threshold,
+			const VisibleSet &visibleSet, size_t minimumExpansionDepth, Result &result
+		)
+			:	m_perspective( camera->getProjection() == "perspective" ), m_screenWindow( camera->frustum() ),
+				m_threshold( threshold ), m_visibleSet( visibleSet ), m_minimumExpansionDepth( minimumExpansionDepth ),
+				m_parentToCamera( worldToCamera ), m_result( result )
+		{
+		}
+
+		CameraPriorityGatherer( const CameraPriorityGatherer &parent )
+			:	m_perspective( parent.m_perspective ), m_screenWindow( parent.m_screenWindow ),
+				m_threshold( parent.m_threshold ), m_visibleSet( parent.m_visibleSet ), m_minimumExpansionDepth( parent.m_minimumExpansionDepth ),
+				m_parentToCamera( parent.m_localToCamera ), m_result( parent.m_result )
+		{
+		}
+
+		bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+		{
+			m_localToCamera = path.size() ? scene->transformPlug()->getValue() * m_parentToCamera : m_parentToCamera;
+			const Box3f bound = Imath::transform( scene->boundPlug()->getValue(), m_localToCamera );
+			if( bound.isEmpty() || screenFraction( bound ) < m_threshold )
+			{
+				return false;
+			}
+
+			// Only consider the locations that `updateInternal()` will render.
+			const VisibleSet::Visibility visibility = m_visibleSet.visibility( path, m_minimumExpansionDepth );
+			if( visibility.drawMode == VisibleSet::Visibility::Visible )
+			{
+				tbb::spin_mutex::scoped_lock lock( m_result.mutex );
+				m_result.paths.addPath( path );
+			}
+			return visibility.descendantsVisible;
+		}
+
+	private :
+
+		float screenFraction( const Box3f &bound ) const
+		{
+			if( m_perspective && bound.max.z >= 0.0f )
+			{
+				if( bound.min.z >= 0.0f )
+				{
+					// Entirely behind the camera.
+					return 0.0f;
+				}
+				// Bound contains the camera or is partially behind it. It
+				// may cover the entire screen, so we treat it as significant.
+				return std::numeric_limits<float>::max();
+			}
+
+			Box2f projected;
+			for( int i = 0; i < 8; ++i )
+			{
+				const V3f p(
+					i & 1 ? bound.max.x : bound.min.x,
+					i & 2 ? bound.max.y : bound.min.y,
+					i & 4 ? bound.max.z : bound.min.z
+				);
+				projected.extendBy( m_perspective ? V2f( p.x, p.y ) / -p.z : V2f( p.x, p.y ) );
+			}
+
+			// Intersect with the screen window, so that offscreen locations are
+			// ignored and partially offscreen ones are measured appropriately.
+			const Box2f visible(
+				V2f( std::max( projected.min.x, m_screenWindow.min.x ), std::max( projected.min.y, m_screenWindow.min.y ) ),
+				V2f( std::min( projected.max.x, m_screenWindow.max.x ), std::min( projected.max.y, m_screenWindow.max.y ) )
+			);
+			if( visible.isEmpty() )
+			{
+				return 0.0f;
+			}
+
+			const V2f size = visible.size();
+			const V2f screenSize = m_screenWindow.size();
+			return ( size.x * size.y ) / ( screenSize.x * screenSize.y );
+		}
+
+		const bool m_perspective;
+		const Box2f m_screenWindow;
+		const float m_threshold;
+		const VisibleSet &m_visibleSet;
+		const size_t m_minimumExpansionDepth;
+		// Transform from the parent location to camera space.
+		const M44f m_parentToCamera;
+		// Transform from the current location to camera space.
+		M44f m_localToCamera;
+		Result &m_result;
+
+};
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // RenderController
 //////////////////////////////////////////////////////////////////////////
@@ -1259,6 +1387,7 @@ class RenderController::SceneGraph
 RenderController::RenderController( const ConstScenePlugPtr &scene, const Gaffer::ConstContextPtr &context, const IECoreScenePreview::RendererPtr &renderer )
 	:	m_renderer( renderer ),
 		m_minimumExpansionDepth( 0 ),
+		m_cameraPriorityThreshold( 0.0f ),
 		m_updateRequired( false ),
 		m_updateRequested( false ),
 		m_failedAttributeEdits( 0 ),
@@ -1406,6 +1535,18 @@ size_t RenderController::getMinimumExpansionDepth() const
 	return m_minimumExpansionDepth;
 }
 
+void RenderController::setCameraPriorityThreshold( float threshold )
+{
+	// No need to cancel the background task or request an update, as the
+	// threshold only affects the order in which future updates are made.
+	m_cameraPriorityThreshold = threshold;
+}
+
+float RenderController::getCameraPriorityThreshold() const
+{
+	return m_cameraPriorityThreshold;
+}
+
 void RenderController::setManifestRequired( bool manifestRequired )
 {
 	if( manifestRequired == m_manifestRequired )
@@ -1562,10 +1703,37 @@ std::shared_ptr<Gaffer::BackgroundTask> RenderController::updateInBackground( co
 	m_backgroundTask = ParallelAlgo::callOnBackgroundThread(
 		// Subject
 		m_scene.get(),
-		[this, callback, priorityPaths] {
-			if( !priorityPaths.isEmpty() )
+		[this, callback, priorityPaths, cameraPriorityThreshold = m_cameraPriorityThreshold] {
+			IECore::PathMatcher allPriorityPaths = priorityPaths;
+			if( cameraPriorityThreshold > 0.0f )
+			{
+				// We're outside of `updateInternal()` here, so must report
+				// cancellation and errors in the same way it does.
+				try
+				{
+					allPriorityPaths.addPaths( cameraPriorityPaths( cameraPriorityThreshold ) );
+				}
+				catch( const IECore::Cancelled & )
+				{
+					if( callback )
+					{
+						callback( BackgroundTask::Cancelled );
+					}
+					throw;
+				}
+				catch( ... )
+				{
+					m_updateRequired = false;
+					if( callback )
+					{
+						callback( BackgroundTask::Errored );
+					}
+					throw;
+				}
+			}
+			if( !allPriorityPaths.isEmpty() )
 			{
-				updateInternal( callback, &priorityPaths, /* signalCompletion = */ false );
+				updateInternal( callback, &allPriorityPaths, /* signalCompletion = */ false );
 			}
 			updateInternal( callback );
 		}
@@ -1799,6 +1967,41 @@ void RenderController::updateDefaultCamera()
 	m_renderer->option( "camera", name.get() );
 }
 
+IECore::PathMatcher RenderController::cameraPriorityPaths( float threshold ) const
+{
+	ConstCompoundObjectPtr globals = m_scene->globalsPlug()->getValue();
+	const StringData *cameraOption = globals->member<StringData>( g_cameraGlobalName );
+	if( !cameraOption || cameraOption->readable().empty() )
+	{
+		return IECore::PathMatcher();
+	}
+
+	ScenePlug::ScenePath cameraPath;
+	ScenePlug::stringToPath( cameraOption->readable(), cameraPath );
+	if( !m_scene->exists( cameraPath ) )
+	{
+		return IECore::PathMatcher();
+	}
+
+	ConstCameraPtr camera = runTimeCast<const Camera>( m_scene->object( cameraPath ) );
+	if( !camera )
+	{
+		return IECore::PathMatcher();
+	}
+
+	CameraPtr cameraWithGlobals = camera->copy();
+	SceneAlgo::applyCameraGlobals( cameraWithGlobals.get(), globals.get(), m_scene.get() );
+
+	CameraPriorityGatherer::Result result;
+	CameraPriorityGatherer gatherer(
+		cameraWithGlobals.get(), m_scene->fullTransform( cameraPath ).inverse(),
+		threshold, m_visibleSet, m_minimumExpansionDepth, result
+	);
+	SceneAlgo::parallelProcessLocations( m_scene.get(), gatherer );
+
+	return result.paths;
+}
+
 void RenderController::cancelBackgroundTask()
 {
 	if( m_backgroundTask )
@@ -63,6 +63,7 @@
 #include "boost/algorithm/string/predicate.hpp"
 
 #include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_reduce.h"
 #include "tbb/parallel_for.h"
 #include "tbb/task.h"
@@ -70,6 +71,8 @@
 #include "fmt/format.h"
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
 
 using namespace std;
 using namespace Imath;
@@ -916,7 +919,7 @@ namespace RendererAlgo
 
 LightLinks::LightLinks( const IECoreScenePreview::Renderer *renderer )
 	:	m_shadowedLightsFallbackAttributeName( renderer->name() == "Arnold" ? &g_shadowGroupAttributeName : nullptr ),
-		m_lightLinksDirty( true ), m_lightFilterLinksDirty( true )
+		m_lightLinksGeneration( 0 ), m_lightLinksDirty( true ), m_lightFilterLinksDirty( true )
 {
 }
 
@@ -1039,7 +1042,14 @@ void LightLinks::setsDirtied()
 	{
 		f.second.filteredLightsDirty = true;
 	}
-	clearLightLinks();
+	// Rather than clear our light links, we mark them as needing validation.
+	// Then `linkedLights()` can reuse them if the hash of the relevant sets
+	// is unchanged, which in turn allows `outputLightLinks()` to avoid
+	// relinking objects.
+	for( auto &l : m_lightLinks )
+	{
+		l.second.setsDirty = true;
+	}
 	m_lightLinksDirty = true;
 	m_lightFilterLinksDirty = true;
 }
@@ -1066,6 +1076,8 @@ void LightLinks::clearLightLinks()
 	// `clear()` is not threadsafe - hence the mutex.
 	tbb::spin_mutex::scoped_lock l( m_lightLinksClearMutex );
 	m_lightLinks.clear();
+	m_uniqueLightSets.clear();
+	m_lightLinksGeneration++;
 }
 
 std::string LightLinks::filteredLightsExpression( const IECore::CompoundObject *attributes ) const
@@ -1076,45 +1088,89 @@ std::string LightLinks::filteredLightsExpression( const IECore::CompoundObject *
 
 void LightLinks::outputLightLinks( const ScenePlug *scene, const IECore::CompoundObject *attributes, IECoreScenePreview::Renderer::ObjectInterface *object, IECore::MurmurHash *hash ) const
 {
-	const StringData *linkedLightsExpressionData = attributes->member<StringData>( g_linkedLightsAttributeName );
-	const StringData *shadowedLightsExpressionData = attributes->member<StringData>( g_shadowedLightsAttributeName );
-	if( !shadowedLightsExpressionData && m_shadowedLightsFallbackAttributeName )
-	{
-		shadowedLightsExpressionData = attributes->member<StringData>( *m_shadowedLightsFallbackAttributeName );
-	}
-	const std::string linkedLightsExpression = linkedLightsExpressionData ? linkedLightsExpressionData->readable() : "defaultLights";
-	const std::string &shadowedLightsExpression = shadowedLightsExpressionData ? shadowedLightsExpressionData->readable() : g_shadowedLightsDefaultValue;
+	IECoreScenePreview::Renderer::ConstObjectSetPtr lights;
+	IECoreScenePreview::Renderer::ConstObjectSetPtr shadowedLights;
+	linkedLights( scene, attributes, lights, shadowedLights );
 
 	if( hash )
 	{
+		// Sets are unique within a generation (see `uniqueLightSet()`), so we can
+		// identify them by address. This allows us to avoid relinking when the
+		// attributes or sets have changed, but the lights we are linked to haven't.
 		IECore::MurmurHash h;
-		h.append( linkedLightsExpression );
-		h.append( shadowedLightsExpression );
-		if( !m_lightLinksDirty && *hash == h )
-		{
-			// We're only being called because the attributes have changed as a whole, but the
-			// specific attributes we care about haven't changed. No need to relink anything.
-			/// \todo Investigate other optimisations. Perhaps `setExpressionHash()` is fast enough
-			/// that we could use it to avoid editing links when sets have been dirtied but the
-			/// specific sets we care about haven't changed?
+		h.append( m_lightLinksGeneration.load() );
+		h.append( (uint64_t)lights.get() );
+		h.append( (uint64_t)shadowedLights.get() );
+		if( *hash == h )
+		{
 			return;
 		}
 		*hash = h;
 	}
 
-	IECoreScenePreview::Renderer::ConstObjectSetPtr objectSet = linkedLights( linkedLightsExpression, scene );
-	object->link( g_lights, objectSet );
-	objectSet = linkedLights( shadowedLightsExpression, scene );
-	object->link( g_shadowedLightsAttributeName, objectSet );
+	object->link( g_lights, lights );
+	object->link( g_shadowedLightsAttributeName, shadowedLights );
+}
+
+void LightLinks::outputLightLinks( const ScenePlug *scene, const IECore::CompoundObject *attributes, IECoreScenePreview::Renderer::ObjectDescription &description ) const
+{
+	IECoreScenePreview::Renderer::ConstObjectSetPtr lights;
+	IECoreScenePreview::Renderer::ConstObjectSetPtr shadowedLights;
+	linkedLights( scene, attributes, lights, shadowedLights );
+
+	description.links.emplace_back( g_lights, lights );
+	description.links.emplace_back( g_shadowedLightsAttributeName, shadowedLights );
+}
+
+void LightLinks::linkedLights( const ScenePlug *scene, const IECore::CompoundObject *attributes, IECoreScenePreview::Renderer::ConstObjectSetPtr &lights, IECoreScenePreview::Renderer::ConstObjectSetPtr &shadowedLights ) const
+{
+	const StringData *linkedLightsExpressionData = attributes->member<StringData>( g_linkedLightsAttributeName );
+	const StringData *shadowedLightsExpressionData = attributes->member<StringData>( g_shadowedLightsAttributeName );
+	if( !shadowedLightsExpressionData && m_shadowedLightsFallbackAttributeName )
+	{
+		shadowedLightsExpressionData = attributes->member<StringData>( *m_shadowedLightsFallbackAttributeName );
+	}
+	const std::string linkedLightsExpression = linkedLightsExpressionData ? linkedLightsExpressionData->readable() : "defaultLights";
+	const std::string &shadowedLightsExpression = shadowedLightsExpressionData ? shadowedLightsExpressionData->readable() : g_shadowedLightsDefaultValue;
+
+	lights = linkedLights( linkedLightsExpression, scene );
+	shadowedLights = linkedLights( shadowedLightsExpression, scene );
 }
 
 IECoreScenePreview::Renderer::ConstObjectSetPtr LightLinks::linkedLights( const std::string &linkedLightsExpression, const ScenePlug *scene ) const
 {
+	{
+		// Fast path. Most objects share a handful of expressions, so we
+		// use a read lock to avoid serialising on the popular ones.
+		LightLinkMap::const_accessor a;
+		if( m_lightLinks.find( a, linkedLightsExpression ) && !a->second.setsDirty )
+		{
+			return a->second.lights;
+		}
+	}
+
 	LightLinkMap::accessor a;
+	IECore::MurmurHash setsHash;
 	if( !m_lightLinks.insert( a, linkedLightsExpression ) )
 	{
-		// Already did the work
-		return a->second;
+		if( !a->second.setsDirty )
+		{
+			// Another thread did the work while we were waiting for the lock.
+			return a->second.lights;
+		}
+
+		setsHash = SetAlgo::setExpressionHash( linkedLightsExpression, scene );
+		if( setsHash == a->second.setsHash )
+		{
+			// The sets we depend on haven't changed, so we can reuse
+			// the existing links.
+			a->second.setsDirty = false;
+			return a->second.lights;
+		}
+	}
+	else
+	{
+		setsHash = SetAlgo::setExpressionHash( linkedLightsExpression, scene );
 	}
 
 	PathMatcher paths = SetAlgo::evaluateSetExpression( linkedLightsExpression, scene );
@@ -1137,7 +1193,40 @@ IECoreScenePreview::Renderer::ConstObjectSetPtr LightLinks::linkedLights( const
 		objectSet = nullptr;
 	}
 
-	a->second = objectSet;
+	a->second.setsHash = setsHash;
+	a->second.lights = uniqueLightSet( objectSet );
+	a->second.setsDirty = false;
+	return a->second.lights;
+}
+
+IECoreScenePreview::Renderer::ObjectSetPtr LightLinks::uniqueLightSet( const IECoreScenePreview::Renderer::ObjectSetPtr &lights ) const
+{
+	if( !lights )
+	{
+		return lights;
+	}
+
+	// ObjectSet is unordered, so we sort the members to get
+	// a hash that is independent of insertion order.
+	vector<const IECoreScenePreview::Renderer::ObjectInterface *> members;
+	members.reserve( lights->size() );
+	for( const auto &l : *lights )
+	{
+		members.push_back( l.get() );
+	}
+	std::sort( members.begin(), members.end() );
+
+	IECore::MurmurHash h;
+	for( const auto m : members )
+	{
+		h.append( (uint64_t)m );
+	}
+
+	UniqueLightSetMap::accessor a;
+	if( m_uniqueLightSets.insert( a, h ) )
+	{
+		a->second = lights;
+	}
 	return a->second;
 }
 
@@ -1244,7 +1333,7 @@ struct LocationOutput
 {
 
 	LocationOutput( IECoreScenePreview::Renderer *renderer, const GafferScene::Private::RendererAlgo::RenderOptions &renderOptions, const GafferScene::Private::RendererAlgo::RenderSets &renderSets, const ScenePlug::ScenePath &root, const ScenePlug *scene )
-		:	m_renderer( renderer ), m_options( renderOptions ), m_attributes( root.empty() ? SceneAlgo::globalAttributes( renderOptions.globals.get() ) : new CompoundObject ), m_renderSets( renderSets ), m_root( root )
+		:	m_renderer( renderer ), m_options( renderOptions ), m_attributes( root.empty() ? SceneAlgo::globalAttributes( renderOptions.globals.get() ) : new CompoundObject ), m_attributesHash( m_attributes->Object::hash() ), m_renderSets( renderSets ), m_root( root )
 	{
 		m_transformSamples.push_back( M44f() );
 	}
@@ -1316,6 +1405,20 @@ struct LocationOutput
 			return m_attributes.get();
 		}
 
+		const IECore::ConstCompoundObjectPtr &attributesPtr() const
+		{
+			return m_attributes;
+		}
+
+		// Identifies `attributes()`, but is derived from the hashes of the
+		// attributes at each location rather than by hashing the whole
+		// object. Identical attributes may therefore have different hashes
+		// if they were inherited differently.
+		const IECore::MurmurHash &attributesHash() const
+		{
+			return m_attributesHash;
+		}
+
 		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface()
 		{
 			/// \todo Should we keep a cache of AttributesInterfaces so we can share
@@ -1327,6 +1430,12 @@ struct LocationOutput
 			return m_renderer->attributes( m_attributes.get() );
 		}
 
+		void transform( IECoreScenePreview::Renderer::ObjectDescription &description ) const
+		{
+			description.transformSamples = m_transformSamples;
+			description.transformTimes = m_transformTimes;
+		}
+
 		void applyTransform( IECoreScenePreview::Renderer::ObjectInterface *objectInterface )
 		{
 			if( !m_transformSamples.size() )
@@ -1368,6 +1477,21 @@ struct LocationOutput
 			}
 
 			m_attributes = updatedAttributes;
+
+			// The hash of the attributes plug is already in the hash cache
+			// from `getValue()` above, so is much cheaper than hashing
+			// `m_attributes`. We only need to hash the attributes added
+			// by `m_renderSets` ourselves.
+			m_attributesHash.append( scene->attributesPlug()->hash() );
+			for( const auto &name : { g_setsAttributeName, g_lightMuteAttributeName } )
+			{
+				auto it = processedAttributes->members().find( name );
+				if( it != processedAttributes->members().end() )
+				{
+					m_attributesHash.append( name );
+					it->second->hash( m_attributesHash );
+				}
+			}
 		}
 
 		void updateTransform( const ScenePlug *scene )
@@ -1436,6 +1560,7 @@ struct LocationOutput
 
 		const GafferScene::Private::RendererAlgo::RenderOptions m_options;
 		IECore::ConstCompoundObjectPtr m_attributes;
+		IECore::MurmurHash m_attributesHash;
 		const GafferScene::Private::RendererAlgo::RenderSets &m_renderSets;
 		const ScenePlug::ScenePath &m_root;
 
@@ -1628,12 +1753,227 @@ struct LightFiltersOutput : public LocationOutput
 
 };
 
+// Shares AttributesInterfaces and tracks duplicate objects between all the
+// locations output by `outputObjects()`. Scenes generated by Duplicate,
+// Instancer and CollectScenes contain many locations with identical
+// attributes and objects. The renderer backends already instance identical
+// geometry, but converting the attributes is repeated for every call to
+// `Renderer::attributes()`, so we make sure it is only called once per
+// unique attribute block.
+class Deduplicator : boost::noncopyable
+{
+
+	public :
+
+		Deduplicator( IECoreScenePreview::Renderer *renderer )
+			:	m_renderer( renderer ), m_numLocations( 0 ), m_numAttributesReused( 0 ), m_numObjectsReused( 0 ), m_bytesReused( 0 )
+		{
+		}
+
+		~Deduplicator()
+		{
+			if( m_numLocations )
+			{
+				IECore::msg(
+					IECore::Msg::Debug, "RendererAlgo::outputObjects",
+					fmt::format(
+						"Output {} objects with {} unique objects and {} unique attribute blocks. "
+						"Deduplicated {} objects totalling {} bytes, and {} attribute blocks.",
+						m_numLocations.load(), m_objects.size(), m_attributesByHash.size(),
+						m_numObjectsReused.load(), m_bytesReused.load(), m_numAttributesReused.load()
+					)
+				);
+			}
+		}
+
+		// Caches the AttributesInterface for a single attributes object.
+		// Locations without attributes of their own share the `attributes`
+		// object with their parent, so ObjectOutput shares a slot between a
+		// location and its descendants, allowing them to find the interface
+		// without rehashing. The slot is released along with the traversal
+		// of that part of the scene.
+		struct AttributesSlot
+		{
+			AttributesSlot( const IECore::ConstCompoundObjectPtr &attributes, const IECore::MurmurHash &hash )
+				:	attributes( attributes ), hash( hash )
+			{
+			}
+			const IECore::ConstCompoundObjectPtr attributes;
+			const IECore::MurmurHash hash;
+			std::mutex mutex;
+			IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface;
+		};
+		using AttributesSlotPtr = std::shared_ptr<AttributesSlot>;
+
+		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface( AttributesSlot &slot )
+		{
+			std::lock_guard lock( slot.mutex );
+			if( slot.attributesInterface )
+			{
+				m_numAttributesReused++;
+				return slot.attributesInterface;
+			}
+
+			AttributesByHash::accessor a;
+			if( m_attributesByHash.insert( a, slot.hash ) )
+			{
+				a->second = m_renderer->attributes( slot.attributes.get() );
+			}
+			else
+			{
+				m_numAttributesReused++;
+			}
+			slot.attributesInterface = a->second;
+			return slot.attributesInterface;
+		}
+
+		// Returns the memory usage of `samples`.
+		size_t objectOutput( const IECore::MurmurHash &objectHash, const std::vector<IECore::ConstObjectPtr> &samples )
+		{
+			m_numLocations++;
+			ObjectMap::accessor a;
+			if( !m_objects.insert( a, objectHash ) )
+			{
+				m_numObjectsReused++;
+				m_bytesReused += a->second;
+				return a->second;
+			}
+
+			size_t memoryUsage = 0;
+			for( const auto &sample : samples )
+			{
+				memoryUsage += sample->memoryUsage();
+			}
+			a->second = memoryUsage;
+			return memoryUsage;
+		}
+
+	private :
+
+		IECoreScenePreview::Renderer *m_renderer;
+
+		using AttributesByHash = tbb::concurrent_hash_map<IECore::MurmurHash, IECoreScenePreview::Renderer::AttributesInterfacePtr>;
+		AttributesByHash m_attributesByHash;
+
+		// Maps from object hash to memory usage.
+		using ObjectMap = tbb::concurrent_hash_map<IECore::MurmurHash, size_t>;
+		ObjectMap m_objects;
+
+		std::atomic_size_t m_numLocations;
+		std::atomic_size_t m_numAttributesReused;
+		std::atomic_size_t m_numObjectsReused;
+		std::atomic_size_t m_bytesReused;
+
+};
+
+// Accumulates objects from `outputObjects()` into per-thread batches,
+// which are passed to `Renderer::objects()` once they are large enough.
+// Batches are limited by the memory used by their objects as well as by
+// their length, so that heavy geometry is still streamed to the renderer
+// a few objects at a time, rather than being held until the batch fills.
+class ObjectBatcher : boost::noncopyable
+{
+
+	public :
+
+		ObjectBatcher( IECoreScenePreview::Renderer *renderer, RenderManifest *renderManifest )
+			:	m_renderer( renderer ), m_renderManifest( renderManifest )
+		{
+		}
+
+		// Adds an object to the current thread's batch, flushing the batch
+		// if it is full. `samples` and `attributes` are the objects referenced
+		// by `description`, and are kept alive until the batch is flushed.
+		// `memoryUsage` is the memory used by `samples`. If we have a render
+		// manifest, an ID for `path` is acquired and assigned once the renderer
+		// has accepted the object.
+		void add( const ScenePlug::ScenePath &path, IECoreScenePreview::Renderer::ObjectDescription &&description, std::vector<IECore::ConstObjectPtr> &&samples, size_t memoryUsage, const IECoreScenePreview::Renderer::AttributesInterfacePtr &attributes )
+		{
+			Batch &batch = m_batches.local();
+			if( m_renderManifest )
+			{
+				batch.paths.push_back( path );
+			}
+			batch.descriptions.push_back( std::move( description ) );
+			batch.samples.insert( batch.samples.end(), std::make_move_iterator( samples.begin() ), std::make_move_iterator( samples.end() ) );
+			batch.attributes.push_back( attributes );
+			batch.memoryUsage += memoryUsage;
+
+			if( batch.descriptions.size() < g_maxBatchSize && batch.memoryUsage < g_maxBatchMemoryUsage )
+			{
+				return;
+			}
+
+			// Swap the batch out before flushing it, because `Renderer::objects()`
+			// may use TBB, and this thread may therefore steal other tasks from our
+			// traversal, which would add to `m_batches.local()`.
+			Batch toFlush;
+			std::swap( toFlush, batch );
+			flush( toFlush );
+		}
+
+		// Must be called after the traversal is complete, to output the
+		// remaining partial batches.
+		void flushAll()
+		{
+			for( auto &batch : m_batches )
+			{
+				flush( batch );
+			}
+		}
+
+	private :
+
+		static const size_t g_maxBatchSize = 1000;
+		static const size_t g_maxBatchMemoryUsage = 16 * 1024 * 1024;
+
+		struct Batch
+		{
+			std::vector<ScenePlug::ScenePath> paths;
+			std::vector<IECoreScenePreview::Renderer::ObjectDescription> descriptions;
+			std::vector<IECore::ConstObjectPtr> samples;
+			std::vector<IECoreScenePreview::Renderer::AttributesInterfacePtr> attributes;
+			size_t memoryUsage = 0;
+		};
+
+		void flush( Batch &batch )
+		{
+			if( batch.descriptions.empty() )
+			{
+				return;
+			}
+
+			// Batch renderers flush each object when we release the
+			// result, and we have no use for it otherwise.
+			std::vector<IECoreScenePreview::Renderer::ObjectInterfacePtr> result;
+			m_renderer->objects( batch.descriptions, result );
+			if( m_renderManifest )
+			{
+				for( size_t i = 0; i < result.size(); ++i )
+				{
+					if( result[i] )
+					{
+						result[i]->assignID( m_renderManifest->acquireID( batch.paths[i] ) );
+					}
+				}
+			}
+			result.clear();
+
+			batch = Batch();
+		}
+
+		IECoreScenePreview::Renderer *m_renderer;
+		RenderManifest *m_renderManifest;
+		tbb::enumerable_thread_specific<Batch> m_batches;
+
+};
+
 struct ObjectOutput : public LocationOutput
 {
 
-	ObjectOutput( IECoreScenePreview::Renderer *renderer, const GafferScene::Private::RendererAlgo::RenderOptions &renderOptions, const GafferScene::Private::RendererAlgo::RenderSets &renderSets, const GafferScene::Private::RendererAlgo::LightLinks *lightLinks, const ScenePlug::ScenePath &root, const ScenePlug *scene, RenderManifest *renderManifest )
+	ObjectOutput( IECoreScenePreview::Renderer *renderer, const GafferScene::Private::RendererAlgo::RenderOptions &renderOptions, const GafferScene::Private::RendererAlgo::RenderSets &renderSets, const GafferScene::Private::RendererAlgo::LightLinks *lightLinks, const ScenePlug::ScenePath &root, const ScenePlug *scene, Deduplicator &deduplicator, ObjectBatcher &batcher )
 
-		:	LocationOutput( renderer, renderOptions, renderSets, root, scene ), m_cameraSet( renderSets.camerasSet() ), m_lightSet( renderSets.lightsSet() ), m_lightFiltersSet( renderSets.lightFiltersSet() ), m_lightLinks( lightLinks ), m_renderManifest( renderManifest )
+		:	LocationOutput( renderer, renderOptions, renderSets, root, scene ), m_cameraSet( renderSets.camerasSet() ), m_lightSet( renderSets.lightsSet() ), m_lightFiltersSet( renderSets.lightFiltersSet() ), m_lightLinks( lightLinks ), m_deduplicator( deduplicator ), m_batcher( batcher )
 	{
 	}
 
@@ -1644,6 +1984,14 @@ struct ObjectOutput : public LocationOutput
 			return false;
 		}
 
+		// Start a new slot if this location has attributes of its own. Otherwise
+		// we share our parent's, and `*this` will be copied to our children so
+		// they share it too.
+		if( !m_attributesSlot || m_attributesSlot->attributes != attributesPtr() )
+		{
+			m_attributesSlot = std::make_shared<Deduplicator::AttributesSlot>( attributesPtr(), attributesHash() );
+		}
+
 		if( ( m_cameraSet.match( path ) & IECore::PathMatcher::ExactMatch ) || ( m_lightFiltersSet.match( path ) & IECore::PathMatcher::ExactMatch ) || ( m_lightSet.match( path ) & IECore::PathMatcher::ExactMatch ) )
 		{
 			return true;
@@ -1658,52 +2006,51 @@ struct ObjectOutput : public LocationOutput
 		deformationMotionTimes( sampleTimes );
 
 		vector<ConstObjectPtr> samples;
-		GafferScene::Private::RendererAlgo::objectSamples( scene->objectPlug(), sampleTimes, samples );
+		IECore::MurmurHash objectHash;
+		GafferScene::Private::RendererAlgo::objectSamples( scene->objectPlug(), sampleTimes, samples, &objectHash );
 		if( !samples.size() )
 		{
 			return true;
 		}
 
-		IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface;
-		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface = this->attributesInterface();
+		const size_t memoryUsage = m_deduplicator.objectOutput( objectHash, samples );
+
+		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface = m_deduplicator.attributesInterface( *m_attributesSlot );
+
+		IECoreScenePreview::Renderer::ObjectDescription description;
+		description.name = name( path );
+		description.attributes = attributesInterface.get();
+
 		if( samples.size() == 1 )
 		{
-			ConstObjectPtr sample = samples[0];
-			if( auto capsule = runTimeCast<const Capsule>( sample.get() ) )
+			if( auto capsule = runTimeCast<const Capsule>( samples[0].get() ) )
 			{
 				CapsulePtr capsuleCopy = capsule->copy();
 				capsuleCopy->setRenderOptions( renderOptions() );
-				sample = capsuleCopy;
+				samples[0] = capsuleCopy;
 			}
-			objectInterface = renderer()->object( name( path ), sample.get(), attributesInterface.get() );
 		}
 		else
 		{
 			assert( sampleTimes.size() == samples.size() );
-			/// \todo Can we rejig things so this conversion isn't necessary?
-			vector<const Object *> objectsVector; objectsVector.reserve( samples.size() );
-			for( const auto &sample : samples )
-			{
-				objectsVector.push_back( sample.get() );
-			}
-			objectInterface = renderer()->object( name( path ), objectsVector, sampleTimes, attributesInterface.get() );
+			description.sampleTimes = sampleTimes;
 		}
 
-		if( objectInterface )
+		description.samples.reserve( samples.size() );
+		for( const auto &sample : samples )
 		{
-			applyTransform( objectInterface.get() );
-			if( m_lightLinks )
-			{
-				m_lightLinks->outputLightLinks( scene, attributes(), objectInterface.get() );
-			}
+			description.samples.push_back( sample.get() );
+		}
 
-			if( m_renderManifest )
-			{
-				int id = m_renderManifest->acquireID( path );
-				objectInterface->assignID( id );
-			}
+		transform( description );
+
+		if( m_lightLinks )
+		{
+			m_lightLinks->outputLightLinks( scene, attributes(), description );
 		}
 
+		m_batcher.add( path, std::move( description ), std::move( samples ), memoryUsage, attributesInterface );
+
 		return true;
 	}
 
@@ -1711,7 +2058,9 @@ struct ObjectOutput : public LocationOutput
 	const PathMatcher &m_lightSet;
 	const PathMatcher &m_lightFiltersSet;
 	const GafferScene::Private::RendererAlgo::LightLinks *m_lightLinks;
-	RenderManifest *m_renderManifest;
+	Deduplicator &m_deduplicator;
+	ObjectBatcher &m_batcher;
+	Deduplicator::AttributesSlotPtr m_attributesSlot;
 
 };
 
@@ -1943,9 +2292,12 @@ void outputLights( const ScenePlug *scene, const RenderOptions &renderOptions, c
 
 void outputObjects( const ScenePlug *scene, const RenderOptions &renderOptions, const RenderSets &renderSets, const LightLinks *lightLinks, IECoreScenePreview::Renderer *renderer, const ScenePlug::ScenePath &root, RenderManifest *renderManifest )
 {
-	ObjectOutput output( renderer, renderOptions, renderSets, lightLinks, root, scene, renderManifest );
+	Deduplicator deduplicator( renderer );
+	ObjectBatcher batcher( renderer, renderManifest );
+	ObjectOutput output( renderer, renderOptions, renderSets, lightLinks, root, scene, deduplicator, batcher );
 
 	SceneAlgo::parallelProcessLocations( scene, output, root );
+	batcher.flushAll();
 }
 
 } // namespace RendererAlgo
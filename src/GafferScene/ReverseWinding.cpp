@@ -36,7 +36,8 @@
 
 #include "GafferScene/ReverseWinding.h"
 
-#include "IECoreScene/MeshAlgo.h"
+#include "GafferScene/Private/IECoreScenePreview/MeshAlgo.h"
+
 #include "IECoreScene/MeshPrimitive.h"
 
 using namespace IECore;
@@ -73,6 +74,6 @@ IECore::ConstObjectPtr ReverseWinding::computeProcessedObject( const ScenePath &
 	}
 
 	MeshPrimitivePtr meshCopy = mesh->copy();
-	MeshAlgo::reverseWinding( meshCopy.get(), context->canceller() );
+	IECoreScenePreview::MeshAlgo::reverseWinding( meshCopy.get(), context->canceller() );
 	return meshCopy;
 }
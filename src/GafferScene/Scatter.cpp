@@ -37,10 +37,21 @@
 
 #include "GafferScene/Scatter.h"
 
+#include "GafferScene/Private/IECoreScenePreview/PrimitiveAlgo.h"
+
 #include "Gaffer/StringPlug.h"
 
 #include "IECoreScene/MeshAlgo.h"
 
+#include "IECore/DataAlgo.h"
+#include "IECore/StringAlgo.h"
+#include "IECore/TypeTraits.h"
+
+#include "fmt/format.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -48,6 +59,235 @@ using namespace IECoreScene;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Number of faces scattered by each parallel task.
+const size_t g_facesPerChunk = 5000;
+
+DataPtr sliceData( const Data *data, size_t begin, size_t end )
+{
+	return dispatch(
+		data,
+		[begin, end] ( const auto *typedData ) -> DataPtr {
+			using DataType = std::remove_cv_t<std::remove_pointer_t<decltype( typedData )>>;
+			if constexpr( TypeTraits::IsVectorTypedData<DataType>::value )
+			{
+				typename DataType::Ptr result = new DataType;
+				const auto &readable = typedData->readable();
+				result->writable().assign( readable.begin() + begin, readable.begin() + end );
+				if constexpr( TypeTraits::IsGeometricTypedData<DataType>::value )
+				{
+					result->setInterpretation( typedData->getInterpretation() );
+				}
+				return result;
+			}
+			else
+			{
+				throw IECore::Exception( fmt::format( "Unsupported primitive variable type \"{}\"", typedData->typeName() ) );
+			}
+		}
+	);
+}
+
+PrimitiveVariable slicePrimitiveVariable( const PrimitiveVariable &primitiveVariable, size_t begin, size_t end )
+{
+	if( primitiveVariable.indices )
+	{
+		IntVectorDataPtr indices = new IntVectorData;
+		const vector<int> &readable = primitiveVariable.indices->readable();
+		indices->writable().assign( readable.begin() + begin, readable.begin() + end );
+		return PrimitiveVariable( primitiveVariable.interpolation, primitiveVariable.data, indices );
+	}
+	return PrimitiveVariable( primitiveVariable.interpolation, sliceData( primitiveVariable.data.get(), begin, end ) );
+}
+
+// Returns a mesh containing the faces in the range `[beginFace, endFace)`,
+// and the primitive variables in `primitiveVariables`. Vertices are not
+// renumbered, so Vertex and Constant primitive variables can be shared with
+// the source rather than copied.
+MeshPrimitivePtr faceRange( const MeshPrimitive *mesh, const vector<int> &faceOffsets, size_t beginFace, size_t endFace, const vector<InternedString> &primitiveVariables )
+{
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const size_t beginVertex = faceOffsets[beginFace];
+	const size_t endVertex = endFace < faceOffsets.size() ? faceOffsets[endFace] : vertexIds.size();
+
+	IntVectorDataPtr rangeVerticesPerFace = new IntVectorData;
+	rangeVerticesPerFace->writable().assign( verticesPerFace.begin() + beginFace, verticesPerFace.begin() + endFace );
+	IntVectorDataPtr rangeVertexIds = new IntVectorData;
+	rangeVertexIds->writable().assign( vertexIds.begin() + beginVertex, vertexIds.begin() + endVertex );
+
+	MeshPrimitivePtr result = new MeshPrimitive;
+	result->setTopologyUnchecked(
+		rangeVerticesPerFace, rangeVertexIds, mesh->variableSize( PrimitiveVariable::Vertex ), mesh->interpolation()
+	);
+
+	for( const auto &name : primitiveVariables )
+	{
+		const PrimitiveVariable &primitiveVariable = mesh->variables.find( name )->second;
+		switch( primitiveVariable.interpolation )
+		{
+			case PrimitiveVariable::Uniform :
+				result->variables[name] = slicePrimitiveVariable( primitiveVariable, beginFace, endFace );
+				break;
+			case PrimitiveVariable::FaceVarying :
+				result->variables[name] = slicePrimitiveVariable( primitiveVariable, beginVertex, endVertex );
+				break;
+			default :
+				result->variables[name] = primitiveVariable;
+		}
+	}
+
+	return result;
+}
+
+// Equivalent to `MeshAlgo::distributePoints()`, but processing chunks of faces
+// in parallel. `distributePoints()` places points using a fixed tiling of UV
+// space, so the points generated for a face don't depend on the rest of the
+// mesh. Merging the chunks in order therefore gives an identical result
+// regardless of the number of threads used.
+PointsPrimitivePtr distributePoints(
+	const MeshPrimitive *mesh, float density, const std::string &densityMask, const std::string &uvSet,
+	const std::string &refPosition, const std::string &primitiveVariables, const Canceller *canceller
+)
+{
+	const size_t numFaces = mesh->numFaces();
+	if( numFaces <= g_facesPerChunk )
+	{
+		return MeshAlgo::distributePoints(
+			mesh, density, V2f( 0 ), densityMask, uvSet, refPosition, primitiveVariables, canceller
+		);
+	}
+
+	vector<int> faceOffsets;
+	faceOffsets.reserve( numFaces );
+	int offset = 0;
+	for( int numVertices : mesh->verticesPerFace()->readable() )
+	{
+		faceOffsets.push_back( offset );
+		offset += numVertices;
+	}
+
+	// Only the primitive variables used by `distributePoints()` need
+	// to be sliced for each chunk.
+	vector<InternedString> chunkPrimitiveVariables;
+	for( const auto &[name, primitiveVariable] : mesh->variables )
+	{
+		if(
+			name == "P" || name == densityMask || name == uvSet || name == refPosition ||
+			StringAlgo::matchMultiple( name, primitiveVariables )
+		)
+		{
+			chunkPrimitiveVariables.push_back( name );
+		}
+	}
+
+	const size_t numChunks = ( numFaces + g_facesPerChunk - 1 ) / g_facesPerChunk;
+	vector<PointsPrimitivePtr> chunks( numChunks );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numChunks, 1 ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Canceller::check( canceller );
+				MeshPrimitivePtr chunkMesh = faceRange(
+					mesh, faceOffsets, i * g_facesPerChunk, std::min( ( i + 1 ) * g_facesPerChunk, numFaces ),
+					chunkPrimitiveVariables
+				);
+				chunks[i] = MeshAlgo::distributePoints(
+					chunkMesh.get(), density, V2f( 0 ), densityMask, uvSet, refPosition, primitiveVariables, canceller
+				);
+			}
+		},
+		taskGroupContext
+	);
+
+	// `mergePrimitives()` promotes Constant primitive variables to Uniform,
+	// and concatenates the data for indexed primitive variables even when it
+	// is shared by all chunks. We remove such variables before merging and
+	// add them back afterwards, so that the result matches what
+	// `MeshAlgo::distributePoints()` would produce for the whole mesh.
+
+	PrimitiveVariableMap unmergedVariables;
+	for( const auto &[name, primitiveVariable] : chunks[0]->variables )
+	{
+		if( primitiveVariable.interpolation == PrimitiveVariable::Constant )
+		{
+			unmergedVariables[name] = primitiveVariable;
+			continue;
+		}
+
+		if( !primitiveVariable.indices || primitiveVariable.interpolation != PrimitiveVariable::Vertex )
+		{
+			continue;
+		}
+
+		bool sharedData = true;
+		size_t numIndices = 0;
+		for( const auto &chunk : chunks )
+		{
+			auto it = chunk->variables.find( name );
+			if(
+				it == chunk->variables.end() || !it->second.indices ||
+				it->second.interpolation != PrimitiveVariable::Vertex ||
+				( it->second.data != primitiveVariable.data && *it->second.data != *primitiveVariable.data )
+			)
+			{
+				sharedData = false;
+				break;
+			}
+			numIndices += it->second.indices->readable().size();
+		}
+
+		if( sharedData )
+		{
+			IntVectorDataPtr indices = new IntVectorData;
+			indices->writable().reserve( numIndices );
+			for( const auto &chunk : chunks )
+			{
+				const vector<int> &chunkIndices = chunk->variables[name].indices->readable();
+				indices->writable().insert( indices->writable().end(), chunkIndices.begin(), chunkIndices.end() );
+			}
+			unmergedVariables[name] = PrimitiveVariable( PrimitiveVariable::Vertex, primitiveVariable.data, indices );
+		}
+	}
+
+	vector<pair<const Primitive *, M44f>> toMerge;
+	toMerge.reserve( numChunks );
+	for( const auto &chunk : chunks )
+	{
+		for( const auto &[name, primitiveVariable] : unmergedVariables )
+		{
+			chunk->variables.erase( name );
+		}
+		toMerge.push_back( { chunk.get(), M44f() } );
+	}
+
+	PointsPrimitivePtr result = boost::static_pointer_cast<PointsPrimitive>(
+		IECoreScenePreview::PrimitiveAlgo::mergePrimitives( toMerge, canceller )
+	);
+
+	for( const auto &[name, primitiveVariable] : unmergedVariables )
+	{
+		result->variables[name] = primitiveVariable;
+	}
+
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Scatter
+//////////////////////////////////////////////////////////////////////////
+
 GAFFER_NODE_DEFINE_TYPE( Scatter );
 
 size_t Scatter::g_firstPlugIndex = 0;
@@ -239,10 +479,9 @@ IECore::ConstObjectPtr Scatter::computeBranchObject( const ScenePath &sourcePath
 			return outPlug()->objectPlug()->defaultValue();
 		}
 
-		PointsPrimitivePtr result = MeshAlgo::distributePoints(
+		PointsPrimitivePtr result = distributePoints(
 			mesh.get(),
 			densityPlug()->getValue(),
-			V2f( 0 ),
 			densityPrimitiveVariablePlug()->getValue(),
 			uvPlug()->getValue(),
 			referencePositionPlug()->getValue(),
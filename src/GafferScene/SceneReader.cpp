@@ -37,6 +37,7 @@
 #include "GafferScene/SceneReader.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/TransformPlug.h"
 
@@ -48,8 +49,13 @@
 
 #include "boost/bind/bind.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_reduce.h"
+
 #include "fmt/format.h"
 
+#include <filesystem>
+
 using namespace std;
 using namespace boost::placeholders;
 using namespace Imath;
@@ -610,37 +616,129 @@ void SceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::
 	h.append( setName );
 }
 
-static void loadSetWalk( const SceneInterface *s, const InternedString &setName, const Gaffer::Context *context, PathMatcher &set, const vector<InternedString> &path )
+namespace
 {
-	if( s->hasTag( setName, SceneInterface::LocalTag ) )
-	{
-		set.addPath( path );
-	}
+
+PathMatcher loadSetWalk( const SceneInterface *s, const InternedString &setName, const IECore::Canceller *canceller )
+{
+	const bool hasLocalTag = s->hasTag( setName, SceneInterface::LocalTag );
 
 	// Figure out if we need to recurse by querying descendant tags to see if they include
 	// anything we're interested in.
 
-	if( !s->hasTag( setName, SceneInterface::DescendantTag ) )
+	PathMatcher result;
+	if( s->hasTag( setName, SceneInterface::DescendantTag ) )
 	{
-		return;
+		// Recurse to the children in parallel. Sets are returned relative
+		// to `s`, so that the result for each child can be added with the
+		// appropriate prefix.
+
+		SceneInterface::NameList childNames;
+		s->childNames( childNames );
+
+		using ChildRange = tbb::blocked_range<SceneInterface::NameList::const_iterator>;
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		result = tbb::parallel_reduce(
+
+			ChildRange( childNames.begin(), childNames.end() ),
+
+			PathMatcher(),
+
+			[&] ( const ChildRange &range, const PathMatcher &x ) {
+
+				PathMatcher rangeResult = x;
+				ScenePlug::ScenePath prefix( 1 );
+				for( auto it = range.begin(); it != range.end(); ++it )
+				{
+					Canceller::check( canceller );
+					ConstSceneInterfacePtr child = s->child( *it );
+					prefix.back() = *it;
+					rangeResult.addPaths( loadSetWalk( child.get(), setName, canceller ), prefix );
+				}
+				return rangeResult;
+
+			},
+
+			[] ( const PathMatcher &x, const PathMatcher &y ) {
+
+				PathMatcher xy = x;
+				xy.addPaths( y );
+				return xy;
+
+			},
+
+			taskGroupContext
+
+		);
 	}
 
-	// Recurse to the children.
+	if( hasLocalTag )
+	{
+		result.addPath( ScenePlug::ScenePath() );
+	}
 
-	SceneInterface::NameList childNames;
-	s->childNames( childNames );
-	vector<InternedString> childPath( path );
-	childPath.push_back( InternedString() ); // room for the child name
-	for( SceneInterface::NameList::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
+	return result;
+}
+
+// Loading sets via tags requires a traversal of the entire file, so we keep
+// a process-wide index of the sets we have loaded, keyed on the file name
+// and modification time. This allows the sets to be shared between all
+// SceneReaders reading the same file, and to survive eviction from the
+// compute cache.
+
+struct SetIndexGetterKey
+{
+
+	SetIndexGetterKey( const IECore::MurmurHash &hash, const SceneInterface *scene, const InternedString &setName )
+		:	hash( hash ), scene( scene ), setName( setName )
 	{
-		Canceller::check( context->canceller() );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const IECore::MurmurHash hash;
+	const SceneInterface *scene;
+	const InternedString &setName;
+
+};
 
-		ConstSceneInterfacePtr child = s->child( *it );
-		childPath.back() = *it;
-		loadSetWalk( child.get(), setName, context, set, childPath );
+ConstPathMatcherDataPtr setIndexGetter( const SetIndexGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	ConstPathMatcherDataPtr result = new PathMatcherData( loadSetWalk( key.scene, key.setName, canceller ) );
+	cost = result->Object::memoryUsage();
+	return result;
+}
+
+using SetIndex = IECorePreview::LRUCache<IECore::MurmurHash, ConstPathMatcherDataPtr, IECorePreview::LRUCachePolicy::TaskParallel, SetIndexGetterKey>;
+// Don't cache errors, because they may be due to cancellation.
+SetIndex g_setIndex( setIndexGetter, 512 * 1024 * 1024, SetIndex::RemovalCallback(), /* cacheErrors = */ false );
+
+ConstPathMatcherDataPtr loadSet( const SceneInterface *rootScene, const InternedString &setName, const IECore::Canceller *canceller )
+{
+	const std::string fileName = rootScene->fileName();
+	std::error_code errorCode;
+	const auto writeTime = std::filesystem::last_write_time( fileName, errorCode );
+	const auto fileSize = errorCode ? 0 : std::filesystem::file_size( fileName, errorCode );
+	if( errorCode )
+	{
+		// Not a regular file, so we can't tell if it has changed.
+		return new PathMatcherData( loadSetWalk( rootScene, setName, canceller ) );
 	}
+
+	IECore::MurmurHash h;
+	h.append( fileName );
+	h.append( (uint64_t)writeTime.time_since_epoch().count() );
+	h.append( (uint64_t)fileSize );
+	h.append( setName );
+
+	return g_setIndex.get( SetIndexGetterKey( h, rootScene, setName ), canceller );
 }
 
+} // namespace
+
 IECore::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
 	ConstInternedStringVectorDataPtr setNamesData = parent->setNames();
@@ -688,9 +786,7 @@ IECore::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedS
 	}
 	else
 	{
-		PathMatcherDataPtr result = new PathMatcherData;
-		loadSetWalk( rootScene.get(), setNameToRead, context, result->writable(), ScenePath() );
-		return result;
+		return loadSet( rootScene.get(), setNameToRead, context->canceller() );
 	}
 }
 
@@ -703,6 +799,7 @@ void SceneReader::plugSet( Gaffer::Plug *plug )
 	if( plug == refreshCountPlug() )
 	{
 		SharedSceneInterfaces::clear();
+		g_setIndex.clear();
 		m_lastScene.clear();
 	}
 }
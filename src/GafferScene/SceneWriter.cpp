@@ -45,6 +45,7 @@
 #include "IECoreScene/SceneInterface.h"
 
 #include <filesystem>
+#include <map>
 #include <unordered_map>
 
 using namespace std;
@@ -63,9 +64,21 @@ struct LocationData
 			m_attributes( scene->attributesPlug()->getValue() ),
 			m_object( scene->objectPlug()->getValue() ),
 			m_bound( scene->boundPlug()->getValue() ),
-			m_transform( scene->transformPlug()->getValue() ),
 			m_childNames( scene->childNamesPlug()->getValue() )
 	{
+		if( path.size() )
+		{
+			// Convert the transform here rather than in `write()`, since
+			// we are called in parallel and `write()` is called serially.
+			const Imath::M44f transform = scene->transformPlug()->getValue();
+			m_transform = new IECore::M44dData( Imath::M44d(
+				transform[0][0], transform[0][1], transform[0][2], transform[0][3],
+				transform[1][0], transform[1][1], transform[1][2], transform[1][3],
+				transform[2][0], transform[2][1], transform[2][2], transform[2][3],
+				transform[3][0], transform[3][1], transform[3][2], transform[3][3]
+			) );
+		}
+
 		if( setsForTags )
 		{
 			const CompoundDataMap &setsMap = setsForTags->readable();
@@ -82,14 +95,18 @@ struct LocationData
 		}
 	}
 
-	void write( IECoreScene::SceneInterface *root, float time ) const
+	const ScenePlug::ScenePath &path() const
 	{
-		SceneInterfacePtr scene = root;
-		for( auto &p : m_path )
-		{
-			scene = scene->child( p, SceneInterface::CreateIfMissing );
-		}
+		return m_path;
+	}
 
+	size_t numChildren() const
+	{
+		return m_childNames->readable().size();
+	}
+
+	void write( IECoreScene::SceneInterface *scene, float time ) const
+	{
 		if( m_object->typeId() != IECore::NullObjectTypeId && m_path.size() > 0 )
 		{
 			scene->writeObject( m_object.get(), time );
@@ -97,15 +114,9 @@ struct LocationData
 
 		scene->writeBound( Imath::Box3d( Imath::V3f( m_bound.min ), Imath::V3f( m_bound.max ) ), time );
 
-		if( m_path.size() )
+		if( m_transform )
 		{
-			M44dDataPtr td = new IECore::M44dData( Imath::M44d (
-				m_transform[0][0], m_transform[0][1], m_transform[0][2], m_transform[0][3],
-				m_transform[1][0], m_transform[1][1], m_transform[1][2], m_transform[1][3],
-				m_transform[2][0], m_transform[2][1], m_transform[2][2], m_transform[2][3],
-				m_transform[3][0], m_transform[3][1], m_transform[3][2], m_transform[3][3]
-			) );
-			scene->writeTransform( td.get(), time );
+			scene->writeTransform( m_transform.get(), time );
 		}
 
 		for( const auto &[name, value] : m_attributes->members() )
@@ -133,12 +144,82 @@ struct LocationData
 		ConstCompoundObjectPtr m_attributes;
 		ConstObjectPtr m_object;
 		Imath::Box3f m_bound;
-		Imath::M44f m_transform;
+		M44dDataPtr m_transform;
 		ConstInternedStringVectorDataPtr m_childNames;
 		SceneInterface::NameList m_tags;
 
 };
 
+// Provides the SceneInterface for each location as it is written. Rather than
+// walk down from the root for every location, which is costly in the serial
+// part of the write, we keep the SceneInterfaces for locations whose children
+// have not all been written yet, and create each location directly from its
+// parent. Locations are released as soon as all their children have been
+// visited, so the number held is bounded by the traversal frontier rather
+// than the size of the scene.
+class LocationCache
+{
+
+	public :
+
+		LocationCache( SceneInterface *root )
+			:	m_root( root )
+		{
+		}
+
+		SceneInterfacePtr location( const ScenePlug::ScenePath &path, size_t numChildren )
+		{
+			SceneInterfacePtr result;
+			if( path.empty() )
+			{
+				result = m_root;
+			}
+			else
+			{
+				const ScenePlug::ScenePath parentPath( path.begin(), path.end() - 1 );
+				auto it = m_locations.find( parentPath );
+				if( it != m_locations.end() )
+				{
+					result = it->second.scene->child( path.back(), SceneInterface::CreateIfMissing );
+					if( --it->second.remainingChildren == 0 )
+					{
+						m_locations.erase( it );
+					}
+				}
+				else
+				{
+					// `parallelGatherLocations()` always provides parents before
+					// their children, so we don't expect to get here. But walking
+					// from the root is always valid, so we fall back to it.
+					result = m_root;
+					for( const auto &p : path )
+					{
+						result = result->child( p, SceneInterface::CreateIfMissing );
+					}
+				}
+			}
+
+			if( numChildren )
+			{
+				m_locations[path] = { result, numChildren };
+			}
+
+			return result;
+		}
+
+	private :
+
+		struct Location
+		{
+			SceneInterfacePtr scene;
+			size_t remainingChildren;
+		};
+
+		SceneInterfacePtr m_root;
+		std::map<ScenePlug::ScenePath, Location> m_locations;
+
+};
+
 } // namespace
 
 GAFFER_NODE_DEFINE_TYPE( SceneWriter );
@@ -238,6 +319,8 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 			useSetsAPI = SceneReader::useSetsAPI( output.get() );
 		}
 
+		LocationCache locationCache( output.get() );
+
 		SceneAlgo::parallelGatherLocations(
 
 			scene,
@@ -252,7 +335,8 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 			// thread-safe for writing.
 
 			[&] ( const LocationData &locationData ) {
-				locationData.write( output.get(), scope.context()->getTime() );
+				SceneInterfacePtr location = locationCache.location( locationData.path(), locationData.numChildren() );
+				locationData.write( location.get(), scope.context()->getTime() );
 			}
 
 		);
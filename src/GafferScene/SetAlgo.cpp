@@ -40,6 +40,9 @@
 
 #include "GafferScene/SetAlgo.h"
 
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+#include "Gaffer/ThreadState.h"
+
 #include "IECore/MessageHandler.h"
 
 #include "boost/algorithm/string/predicate.hpp"
@@ -51,8 +54,13 @@
 #include "boost/variant/apply_visitor.hpp"
 #include "boost/variant/recursive_variant.hpp"
 
+#include "tbb/parallel_invoke.h"
+#include "tbb/task_arena.h"
+
 #include "fmt/format.h"
 
+#include <memory>
+
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
@@ -236,16 +244,48 @@ struct AstEvaluator
 
 	result_type operator()( const BinaryOp &expr ) const
 	{
-		PathMatcher left = boost::apply_visitor( *this, expr.left );
-		PathMatcher right = boost::apply_visitor( *this, expr.right );
+		PathMatcher left;
+		PathMatcher right;
+		if( isCompound( expr.left ) || isCompound( expr.right ) )
+		{
+			// The operands are independent, so we evaluate them in parallel.
+			// This is most beneficial for large expressions where each side
+			// requires the computation of several sets. We isolate the tasks
+			// because our callers may be holding locks, and must not have
+			// unrelated work stolen onto their thread while they wait.
+			const ThreadState &threadState = ThreadState::current();
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::this_task_arena::isolate(
+				[&] {
+					tbb::parallel_invoke(
+						[&] {
+							ThreadState::Scope threadStateScope( threadState );
+							left = boost::apply_visitor( *this, expr.left );
+						},
+						[&] {
+							ThreadState::Scope threadStateScope( threadState );
+							right = boost::apply_visitor( *this, expr.right );
+						},
+						taskGroupContext
+					);
+				}
+			);
+		}
+		else
+		{
+			left = boost::apply_visitor( *this, expr.left );
+			right = boost::apply_visitor( *this, expr.right );
+		}
 
 		switch( expr.op )
 		{
 			case Union :
 			{
-				PathMatcher result = PathMatcher( left );
-				result.addPaths( right );
-				return result;
+				// PathMatcher shares unmodified subtrees between copies,
+				// so modifying `left` in place only duplicates the nodes
+				// that are actually changed by the union.
+				left.addPaths( right );
+				return left;
 			}
 			case Intersection :
 			{
@@ -253,9 +293,8 @@ struct AstEvaluator
 			}
 			case Difference :
 			{
-				PathMatcher result = PathMatcher( left );
-				result.removePaths( right );
-				return result;
+				left.removePaths( right );
+				return left;
 			}
 			case In :
 			{
@@ -286,6 +325,23 @@ struct AstEvaluator
 
 	const ScenePlug *m_scene;
 
+	private :
+
+		// Returns true if evaluating `ast` may involve the computation
+		// of more than one set.
+		static bool isCompound( const ExpressionAst &ast )
+		{
+			if( boost::get<BinaryOp>( &ast ) )
+			{
+				return true;
+			}
+			else if( auto identifier = boost::get<std::string>( &ast ) )
+			{
+				return identifier->size() && (*identifier)[0] != '/' && StringAlgo::hasWildcards( *identifier );
+			}
+			return false;
+		}
+
 };
 
 // Hashing the AST
@@ -482,6 +538,62 @@ void expressionToAST( const std::string &setExpression, ExpressionAst &ast)
 	}
 }
 
+// Caching
+// -------
+//
+// Parsing is relatively expensive, and the same expressions tend to be
+// evaluated over and over again, from SetFilters, render outputs and the
+// UI. So we cache the parsed AST keyed on the expression string.
+
+using ConstExpressionAstPtr = std::shared_ptr<const ExpressionAst>;
+
+ConstExpressionAstPtr astCacheGetter( const std::string &setExpression, size_t &cost, const IECore::Canceller *canceller )
+{
+	cost = 1;
+	auto ast = std::make_shared<ExpressionAst>();
+	expressionToAST( setExpression, *ast );
+	return ast;
+}
+
+using AstCache = IECorePreview::LRUCache<std::string, ConstExpressionAstPtr>;
+AstCache g_astCache( astCacheGetter, 10000 );
+
+// We also cache the results of evaluation, keyed on the hash of the
+// expression, which captures the hashes of all the sets it references.
+// This allows the same expression to be evaluated for many
+// locations (as is common for light linking) or many times by the UI
+// without recomputing the unions and intersections each time.
+
+struct ResultCacheGetterKey
+{
+
+	ResultCacheGetterKey( const IECore::MurmurHash &hash, const ExpressionAst &ast, const ScenePlug *scene )
+		:	hash( hash ), ast( ast ), scene( scene )
+	{
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const IECore::MurmurHash hash;
+	const ExpressionAst &ast;
+	const ScenePlug *scene;
+
+};
+
+PathMatcher resultCacheGetter( const ResultCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	cost = 1;
+	return boost::apply_visitor( AstEvaluator( key.scene ), key.ast );
+}
+
+using ResultCache = IECorePreview::LRUCache<IECore::MurmurHash, PathMatcher, IECorePreview::LRUCachePolicy::TaskParallel, ResultCacheGetterKey>;
+// Don't cache errors, because they may be due to cancellation or other
+// transient upstream failures.
+ResultCache g_resultCache( resultCacheGetter, 200, ResultCache::RemovalCallback(), /* cacheErrors = */ false );
+
 } // namespace
 
 namespace GafferScene
@@ -492,18 +604,25 @@ namespace SetAlgo
 
 PathMatcher evaluateSetExpression( const std::string &setExpression, const ScenePlug *scene )
 {
-	ExpressionAst ast;
-	expressionToAST( setExpression, ast );
-	return boost::apply_visitor( AstEvaluator( scene ), ast );
+	ConstExpressionAstPtr ast = g_astCache.get( setExpression );
+	if( !scene || boost::get<Nil>( ast.get() ) )
+	{
+		return boost::apply_visitor( AstEvaluator( scene ), *ast );
+	}
+
+	IECore::MurmurHash h;
+	h.append( setExpression );
+	AstHasher hasher( scene, h );
+	boost::apply_visitor( hasher, *ast );
+
+	return g_resultCache.get( ResultCacheGetterKey( h, *ast, scene ), Context::current()->canceller() );
 }
 
 void setExpressionHash( const std::string &setExpression, const ScenePlug* scene, IECore::MurmurHash &h )
 {
-	ExpressionAst ast;
-	expressionToAST( setExpression, ast );
-
+	ConstExpressionAstPtr ast = g_astCache.get( setExpression );
 	AstHasher hasher = AstHasher( scene, h );
-	boost::apply_visitor( hasher, ast );
+	boost::apply_visitor( hasher, *ast );
 }
 
 IECore::MurmurHash setExpressionHash( const std::string &setExpression, const ScenePlug* scene)
@@ -91,6 +91,12 @@ void setMinimumExpansionDepth( RenderController &r, size_t depth )
 	r.setMinimumExpansionDepth( depth );
 }
 
+void setCameraPriorityThreshold( RenderController &r, float threshold )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	r.setCameraPriorityThreshold( threshold );
+}
+
 void setManifestRequired( RenderController &r, bool manifestRequired )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -154,6 +160,8 @@ void GafferSceneModule::bindRenderController()
 		.def( "getVisibleSet", &RenderController::getVisibleSet, return_value_policy<copy_const_reference>() )
 		.def( "setMinimumExpansionDepth", &setMinimumExpansionDepth )
 		.def( "getMinimumExpansionDepth", &RenderController::getMinimumExpansionDepth )
+		.def( "setCameraPriorityThreshold", &setCameraPriorityThreshold )
+		.def( "getCameraPriorityThreshold", &RenderController::getCameraPriorityThreshold )
 		.def( "setManifestRequired", &setManifestRequired )
 		.def( "getManifestRequired", &RenderController::getManifestRequired )
 		.def( "updateRequiredSignal", &RenderController::updateRequiredSignal, return_internal_reference<1>() )
@@ -38,6 +38,7 @@
 
 #include "GafferScene/DeleteAttributes.h"
 #include "GafferScene/DeleteObject.h"
+#include "GafferScene/DeleteSets.h"
 #include "GafferScene/PathFilter.h"
 #include "GafferScene/Prune.h"
 #include "GafferScene/SceneAlgo.h"
@@ -48,6 +49,8 @@
 
 #include "IECoreScene/SceneInterface.h"
 
+#include "IECore/StringAlgo.h"
+
 IECORE_PUSH_DEFAULT_VISIBILITY
 #include "pxr/usd/sdf/attributeSpec.h"
 #include "pxr/usd/sdf/layer.h"
@@ -56,9 +59,12 @@ IECORE_POP_DEFAULT_VISIBILITY
 
 #include "boost/filesystem.hpp"
 
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
 
 #include <filesystem>
+#include <memory>
+#include <unordered_set>
 
 using namespace std;
 using namespace pxr;
@@ -192,6 +198,69 @@ Filters buildFilters( const GafferScene::ScenePlug *baseScene, const GafferScene
 	);
 }
 
+// Returns the names of sets which are identical in `baseScene` and
+// `layerScene`, formatted as a match pattern for DeleteSets. These don't need
+// to be written to either of the intermediate files, since they would only be
+// removed again by `createDiff()`. This keeps the size of the intermediate
+// files proportional to the size of the differences, rather than the total
+// size of all sets.
+std::string identicalSets( const GafferScene::ScenePlug *baseScene, const GafferScene::ScenePlug *layerScene, const std::vector<float> &frames )
+{
+	// Sets are written by the SceneWriter at the first frame only.
+	Context::EditableScope scope( Context::current() );
+	scope.setFrame( frames[0] );
+
+	ConstInternedStringVectorDataPtr baseSetNamesData = baseScene->setNamesPlug()->getValue();
+	ConstInternedStringVectorDataPtr layerSetNamesData = layerScene->setNamesPlug()->getValue();
+	const unordered_set<InternedString> layerSetNames( layerSetNamesData->readable().begin(), layerSetNamesData->readable().end() );
+
+	vector<InternedString> candidates;
+	for( const auto &setName : baseSetNamesData->readable() )
+	{
+		if(
+			layerSetNames.count( setName ) &&
+			// We can only delete sets whose names can be matched exactly.
+			!IECore::StringAlgo::hasWildcards( setName.string() ) &&
+			setName.string().find( '\\' ) == string::npos &&
+			setName.string().find( ' ' ) == string::npos
+		)
+		{
+			candidates.push_back( setName );
+		}
+	}
+
+	std::unique_ptr<bool[]> identical( new bool[candidates.size()] );
+	const ThreadState &threadState = ThreadState::current();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, candidates.size() ),
+		[&] ( const tbb::blocked_range<size_t> &r ) {
+			ScenePlug::SetScope setScope( threadState );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				setScope.setSetName( &candidates[i] );
+				identical[i] = baseScene->setPlug()->hash() == layerScene->setPlug()->hash();
+			}
+		},
+		taskGroupContext
+	);
+
+	string result;
+	for( size_t i = 0; i < candidates.size(); ++i )
+	{
+		if( identical[i] )
+		{
+			if( result.size() )
+			{
+				result += " ";
+			}
+			result += candidates[i].string();
+		}
+	}
+
+	return result;
+}
+
 class ScopedDirectory : boost::noncopyable
 {
 
@@ -384,6 +453,8 @@ USDLayerWriter::USDLayerWriter( const std::string &name )
 	const NameValuePlug *pruneQuery = contextQuery->addQuery( queryPrototype.get(), "usdLayerWriter:pruneFilter" );
 	const NameValuePlug *deleteObjectQuery = contextQuery->addQuery( queryPrototype.get(), "usdLayerWriter:deleteObjectFilter" );
 	const NameValuePlug *deleteAttributesQuery = contextQuery->addQuery( queryPrototype.get(), "usdLayerWriter:deleteAttributesFilter" );
+	ConstValuePlugPtr stringQueryPrototype = new StringPlug( "stringQueryPrototype" );
+	const NameValuePlug *deleteSetsQuery = contextQuery->addQuery( stringQueryPrototype.get(), "usdLayerWriter:deleteSets" );
 	addChild( contextQuery );
 
 	PathFilterPtr pruneFilter = new PathFilter( "__pruneFilter" );
@@ -417,7 +488,15 @@ USDLayerWriter::USDLayerWriter( const std::string &name )
 	deleteAttributes->namesPlug()->setValue( "*" );
 	addChild( deleteAttributes );
 
-	sceneWriter->inPlug()->setInput( deleteAttributes->outPlug() );
+	// Sets are passed through the Prune unchanged, so we delete any which are
+	// identical between `base` and `layer` separately.
+
+	DeleteSetsPtr deleteSets = new DeleteSets( "__deleteSets" );
+	deleteSets->inPlug()->setInput( deleteAttributes->outPlug() );
+	deleteSets->namesPlug()->setInput( contextQuery->valuePlugFromQueryPlug( deleteSetsQuery ) );
+	addChild( deleteSets );
+
+	sceneWriter->inPlug()->setInput( deleteSets->outPlug() );
 	sceneWriter->fileNamePlug()->setValue( "${usdLayerWriter:fileName}" );
 
 	outPlug()->setInput( layerPlug() );
@@ -519,6 +598,7 @@ void USDLayerWriter::executeSequence( const std::vector<float> &frames ) const
 	// Figure out the filters for our Prune, DeleteObject and DeleteAttribute
 	// nodes.
 	const Filters filters = buildFilters( basePlug(), layerPlug(), frames );
+	const string deleteSets = identicalSets( basePlug(), layerPlug(), frames );
 
 	// Pass the filter settings via context variables since we can't call
 	// `Plug::setValue()` from `executeSequence()` because it would violate
@@ -532,6 +612,7 @@ void USDLayerWriter::executeSequence( const std::vector<float> &frames ) const
 	context.set( "usdLayerWriter:deleteObjectFilter", &deleteObjectFilter );
 	vector<string> deleteAttributesFilter; filters.deleteAttributes.paths( deleteAttributesFilter );
 	context.set( "usdLayerWriter:deleteAttributesFilter", &deleteAttributesFilter );
+	context.set( "usdLayerWriter:deleteSets", &deleteSets );
 
 	// Write the complete base and layer inputs into temporary USD files. We use
 	// a ScopedDirectory so that the files are cleaned up no matter how we exit
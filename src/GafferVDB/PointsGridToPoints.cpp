@@ -47,6 +47,8 @@
 #include "openvdb/points/PointConversion.h"
 #include "openvdb/points/PointCount.h"
 
+#include "tbb/parallel_for.h"
+
 #include <cstdint>
 
 using namespace std;
@@ -150,21 +152,20 @@ void convert(Imath::Quatd& dest, const openvdb::math::Quatd& src)
 	dest = Imath::Quatd( src[3], src[0], src[1], src[2]);
 }
 
-using LeafIter = openvdb::points::PointDataGrid::TreeType::LeafCIter;
+using LeafNode = openvdb::points::PointDataGrid::TreeType::LeafNodeType;
 
+// Copies the values for the active points in `leaf` into `destArray`, starting at `offset`.
 template<typename CortexType, typename VDBType, template <typename P> class StorageType = IECore::TypedData>
-void appendData(IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)
+void copyData( IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset )
 {
-	auto cortexData = IECore::runTimeCast<StorageType<std::vector<CortexType> > > ( destArray );
-	auto &writable = cortexData->writable();
+	auto cortexData = static_cast<StorageType<std::vector<CortexType> > *>( destArray );
+	CortexType *dest = cortexData->writable().data() + offset;
 
 	openvdb::points::AttributeHandle<VDBType> attributeHandle( array );
 
-	for( auto indexIter = leafIter->beginIndexOn(); indexIter; ++indexIter )
+	for( auto indexIter = leaf.beginIndexOn(); indexIter; ++indexIter )
 	{
-		CortexType d;
-		convert(d, attributeHandle.get( *indexIter ));
-		writable.push_back( d );
+		convert( *dest++, attributeHandle.get( *indexIter ) );
 	}
 };
 
@@ -173,19 +174,19 @@ IECore::DataPtr createArray( size_t size )
 {
 	auto p = new StorageType<std::vector<CortexType> >();
 	auto &writable = p->writable();
-	writable.reserve( size );
+	writable.resize( size );
 	return p;
 };
 
 struct Functions
 {
 	using CreateFn = std::function<IECore::DataPtr ( size_t )>;
-	using AppendFn = std::function<void ( IECore::Data *, const openvdb::points::AttributeArray &, LeafIter )>;
+	using CopyFn = std::function<void ( IECore::Data *, const openvdb::points::AttributeArray &, const LeafNode &, size_t )>;
 
-	Functions( CreateFn create , AppendFn append ) : m_create(create), m_append(append) {}
+	Functions( CreateFn create , CopyFn copy ) : m_create(create), m_copy(copy) {}
 
 	CreateFn m_create;
-	AppendFn m_append;
+	CopyFn m_copy;
 };
 
 const std::map<std::string, Functions >  converters =
@@ -195,42 +196,42 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<half>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<half>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<half, half>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<half, half>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<float>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<float>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<float, float>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<float, float>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<double>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<double>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<double, double>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<double, double>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<uint8_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint8_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint8_t, uint8_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<uint8_t, uint8_t>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<uint16_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint16_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint16_t, uint16_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<uint16_t, uint16_t>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<uint32_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint32_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint32_t, uint32_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<uint32_t, uint32_t>( destArray, array, leaf, offset ); }
 		)
 	},
 	// todo check this function
@@ -238,21 +239,21 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<uint8_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint8_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint8_t, int8_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<uint8_t, int8_t>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<int16_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<int16_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<int16_t, int16_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<int16_t, int16_t>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<int32_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<int32_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<int32_t, int32_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<int32_t, int32_t>( destArray, array, leaf, offset ); }
 		)
 	},
 
@@ -261,21 +262,21 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::Vec2i>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V2i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V2i, openvdb::Vec2i, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V2i, openvdb::Vec2i, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec2s>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V2f, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V2f, openvdb::Vec2s, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V2f, openvdb::Vec2s, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec2d>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V2d, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V2d, openvdb::Vec2d, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V2d, openvdb::Vec2d, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	// Vec3 u8, 16, int, single, double
@@ -283,42 +284,42 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::Vec3U8>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3i, openvdb::Vec3U8, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V3i, openvdb::Vec3U8, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3U16>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3i, openvdb::Vec3U16, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V3i, openvdb::Vec3U16, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3i>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3i, openvdb::Vec3i, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V3i, openvdb::Vec3i, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3s>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3f, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3f, openvdb::Vec3s, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V3f, openvdb::Vec3s, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3d>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3d, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3d, openvdb::Vec3d, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::V3d, openvdb::Vec3d, IECore::GeometricTypedData>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<std::string>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<std::string>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<std::string, std::string>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<std::string, std::string>( destArray, array, leaf, offset ); }
 		)
 	},
 	// matrix conversion - single & double
@@ -326,14 +327,14 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::Mat4s>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::M44f>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::M44f, openvdb::Mat4s>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::M44f, openvdb::Mat4s>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Mat4d>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::M44d>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::M44d, openvdb::Mat4d>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::M44d, openvdb::Mat4d>( destArray, array, leaf, offset ); }
 		)
 	},
 
@@ -342,49 +343,19 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::math::Quats>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::Quatf>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::Quatf, openvdb::math::Quats>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::Quatf, openvdb::math::Quats>( destArray, array, leaf, offset ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::math::Quatd>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::Quatd>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::Quatd, openvdb::math::Quatd>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray &array, const LeafNode &leaf, size_t offset ) { copyData<Imath::Quatd, openvdb::math::Quatd>( destArray, array, leaf, offset ); }
 		)
 	},
 };
 
-void appendPrimitiveVariableData( IECoreScene::PrimitiveVariableMap &variableMap,
-	const std::string &name,
-	const std::string &type,
-	LeafIter leafIter,
-	const openvdb::points::AttributeArray &arrayData,
-	uint64_t count)
-{
-
-	auto itConverter = converters.find( type );
-	if ( itConverter == converters.end() )
-	{
-		return;
-	}
-
-	IECoreScene::PrimitiveVariable primVar;
-
-	auto primVarIt = variableMap.find( name );
-	if( primVarIt == variableMap.end() )
-	{
-		primVar = IECoreScene::PrimitiveVariable( IECoreScene::PrimitiveVariable::Vertex, itConverter->second.m_create( count ) );
-		variableMap[name] = primVar;
-	}
-	else
-	{
-		primVar = primVarIt->second;
-	}
-
-	itConverter->second.m_append( primVar.data.get(), arrayData, leafIter);
-}
-
-IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstPtr baseGrid, std::function<bool( const std::string & )> primitiveVariableFilter )
+IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstPtr baseGrid, std::function<bool( const std::string & )> primitiveVariableFilter, const IECore::Canceller *canceller )
 {
 	openvdb::points::PointDataGrid::ConstPtr pointsGrid = openvdb::GridBase::constGrid<openvdb::points::PointDataGrid>( baseGrid );
 	if( !pointsGrid )
@@ -392,49 +363,89 @@ IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstP
 		return nullptr;
 	}
 
-	openvdb::Index64 count = openvdb::points::pointCount( pointsGrid->tree() );
+	// Gather leaves, and the offset of each leaf's points in the output.
+	// This lets us convert the leaves in parallel below.
+
+	std::vector<const LeafNode *> leaves;
+	std::vector<size_t> offsets;
+	size_t count = 0;
+	for( auto leafIter = pointsGrid->tree().cbeginLeaf(); leafIter; ++leafIter )
+	{
+		leaves.push_back( leafIter.getLeaf() );
+		offsets.push_back( count );
+		count += leafIter->onPointCount();
+	}
 
 	IECore::V3fVectorDataPtr pointData = new IECore::V3fVectorData();
 	auto &points = pointData->writable();
-	points.reserve( count );
+	points.resize( count );
 
-	IECoreScene::PrimitiveVariableMap primVars;
+	// All leaves share the same attribute descriptor, so we can create
+	// our primitive variables up front, from the first leaf.
 
-	for( auto leafIter = pointsGrid->tree().cbeginLeaf(); leafIter; ++leafIter )
+	struct Attribute
 	{
-		const openvdb::points::AttributeArray &array = leafIter->constAttributeArray( "P" );
-		openvdb::points::AttributeHandle<openvdb::Vec3f> positionHandle( array );
+		size_t index;
+		const Functions *functions;
+		IECore::DataPtr data;
+	};
+	std::vector<Attribute> attributes;
 
-		const openvdb::points::AttributeSet &attributeSet = leafIter->attributeSet();
-		const openvdb::points::AttributeSet::Descriptor &descriptor = attributeSet.descriptor();
+	IECoreScene::PointsPrimitivePtr newPoints = new IECoreScene::PointsPrimitive( pointData );
 
-		for (const auto &it : descriptor.map() )
+	if( leaves.size() )
+	{
+		const openvdb::points::AttributeSet::Descriptor &descriptor = leaves.front()->attributeSet().descriptor();
+		for( const auto &it : descriptor.map() )
 		{
-			size_t index = it.second;
 			const std::string &attributeName = it.first;
-			if ( !primitiveVariableFilter( attributeName ) )
+			if( !primitiveVariableFilter( attributeName ) )
 			{
 				continue;
 			}
-			const openvdb::points::AttributeArray *attributeArray = attributeSet.get( index );
-			appendPrimitiveVariableData( primVars, attributeName, descriptor.type( index ).first, leafIter, *attributeArray, count );
-		}
 
-		for( auto indexIter = leafIter->beginIndexOn(); indexIter; ++indexIter )
-		{
-			openvdb::Vec3f voxelPosition = positionHandle.get( *indexIter );
-			const openvdb::Vec3d xyz = indexIter.getCoord().asVec3d();
-			openvdb::Vec3f worldPosition = pointsGrid->transform().indexToWorld( voxelPosition + xyz );
-			points.emplace_back( worldPosition[0], worldPosition[1], worldPosition[2] );
+			auto itConverter = converters.find( descriptor.type( it.second ).first );
+			if( itConverter == converters.end() )
+			{
+				continue;
+			}
+
+			attributes.push_back( { it.second, &itConverter->second, itConverter->second.m_create( count ) } );
+			newPoints->variables[attributeName] = IECoreScene::PrimitiveVariable( IECoreScene::PrimitiveVariable::Vertex, attributes.back().data );
 		}
 	}
 
-	IECoreScene::PointsPrimitivePtr newPoints = new IECoreScene::PointsPrimitive( pointData );
+	const openvdb::math::Transform &transform = pointsGrid->transform();
 
-	for ( auto it : primVars )
-	{
-		newPoints->variables[it.first] = it.second;
-	}
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, leaves.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				IECore::Canceller::check( canceller );
+
+				const LeafNode &leaf = *leaves[i];
+				const openvdb::points::AttributeSet &attributeSet = leaf.attributeSet();
+				for( const auto &attribute : attributes )
+				{
+					attribute.functions->m_copy( attribute.data.get(), *attributeSet.get( attribute.index ), leaf, offsets[i] );
+				}
+
+				openvdb::points::AttributeHandle<openvdb::Vec3f> positionHandle( leaf.constAttributeArray( "P" ) );
+				V3f *point = points.data() + offsets[i];
+				for( auto indexIter = leaf.beginIndexOn(); indexIter; ++indexIter )
+				{
+					openvdb::Vec3f voxelPosition = positionHandle.get( *indexIter );
+					const openvdb::Vec3d xyz = indexIter.getCoord().asVec3d();
+					openvdb::Vec3f worldPosition = transform.indexToWorld( voxelPosition + xyz );
+					*point++ = V3f( worldPosition[0], worldPosition[1], worldPosition[2] );
+				}
+			}
+		},
+		taskGroupContext
+	);
 
 	return newPoints;
 }
@@ -534,7 +545,7 @@ IECore::ConstObjectPtr PointsGridToPoints::computeProcessedObject( const ScenePa
 		return StringAlgo::matchMultiple( primitiveVariableName, names ) != invert;
 	};
 
-	IECoreScene::PointsPrimitivePtr points =  createPointsPrimitive( grid, primitiveVariableFilter );
+	IECoreScene::PointsPrimitivePtr points =  createPointsPrimitive( grid, primitiveVariableFilter, context->canceller() );
 
 	if ( !points )
 	{